@@ -0,0 +1,97 @@
+#define _GNU_SOURCE
+
+#include <malloc.h>
+#include <stdio.h>
+#include <time.h>
+
+#include "../src/alist.h"
+#include "../src/list.h"
+
+static volatile size_t sink;
+
+static double now(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+static size_t heap(void) {
+    struct mallinfo2 info = mallinfo2();
+    return info.uordblks + info.hblkhd;
+}
+
+static void report(const char *name, size_t size, size_t bytes, double times[3]) {
+    printf("%s %zu: %.1f bytes/element, add_tail %.1f ns, walk %.1f ns, delete %.1f ns\n",
+           name, size, (double) bytes / size,
+           times[0] / size, times[1] / size, times[2] / size);
+}
+
+static void bench_list(size_t size) {
+    double times[3];
+    size_t base = heap();
+    List *list = List_new(NULL);
+
+    double start = now();
+    for (size_t i = 0; i < size; i++) {
+        List_add_tail(list, (void *) i);
+    }
+    times[0] = now() - start;
+    size_t bytes = heap() - base;
+
+    start = now();
+    for (Node *node = list->head; node; node = node->next) {
+        sink += (size_t) node->data;
+    }
+    times[1] = now() - start;
+
+    start = now();
+    while (list->head) {
+        List_delete(list, list->head);
+    }
+    times[2] = now() - start;
+
+    List_free(list);
+    report("List", size, bytes, times);
+}
+
+static void bench_alist(size_t size) {
+    double times[3];
+    size_t base = heap();
+    AList *list = AList_new(NULL);
+
+    double start = now();
+    for (size_t i = 0; i < size; i++) {
+        AList_add_tail(list, (void *) i);
+    }
+    times[0] = now() - start;
+    size_t bytes = heap() - base;
+
+    start = now();
+    for (AHandle handle = AList_first(list); handle; handle = AList_next(list, handle)) {
+        sink += (size_t) AList_get(list, handle);
+    }
+    times[1] = now() - start;
+
+    start = now();
+    while (list->size) {
+        AList_delete(list, AList_first(list));
+    }
+    times[2] = now() - start;
+
+    AList_free(list);
+    report("AList", size, bytes, times);
+}
+
+/*
+ * Heap bytes per element and per operation times of a List
+ * and an AList, heap use measured right after filling them
+ */
+int main(int argc, char *argv[]) {
+    size_t max = argc > 1 ? strtoul(argv[1], NULL, 10) : 10000000;
+
+    for (size_t size = 1000; size <= max; size *= 10) {
+        bench_list(size);
+        bench_alist(size);
+    }
+    return 0;
+}
@@ -0,0 +1,71 @@
+#define _POSIX_C_SOURCE 199309L
+
+#include <stdio.h>
+#include <time.h>
+
+#include "../src/list.h"
+
+static double now(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+/*
+ * Build Lists from an array of pointers and copy them back, one
+ * element at a time and in bulk, reporting ns per element
+ */
+int main(int argc, char *argv[]) {
+    size_t max = argc > 1 ? strtoul(argv[1], NULL, 10) : 10000000;
+
+    for (size_t size = 1000; size <= max; size *= 10) {
+        void **data = malloc(size * sizeof(void *));
+        void **out = malloc(size * sizeof(void *));
+        for (size_t i = 0; i < size; i++) {
+            data[i] = (void *) (i + 1);
+        }
+
+        double start = now();
+        List *list = List_new(NULL);
+        for (size_t i = 0; i < size; i++) {
+            List_add_tail(list, data[i]);
+        }
+        double loop = (now() - start) / size;
+
+        start = now();
+        size_t i = 0;
+        for (Node *node = list->head; node; node = node->next) {
+            out[i++] = node->data;
+        }
+        double copy_loop = (now() - start) / size;
+        List_free(list);
+
+        start = now();
+        list = List_new(NULL);
+        List_add_tail_many(list, data, size);
+        double many = (now() - start) / size;
+        List_free(list);
+
+        start = now();
+        Pool *pool = Pool_new(sizeof(Node), 4096);
+        list = List_from_array(data, size, NULL, pool);
+        Pool_free(pool);
+        double from = (now() - start) / size;
+
+        start = now();
+        List_to_array(list, out);
+        double to = (now() - start) / size;
+
+        start = now();
+        List_free(list);
+        double release = (now() - start) / size;
+
+        printf("%zu: add_tail loop %.1f ns, add_tail_many %.1f ns, from_array %.1f ns "
+               "(free %.1f ns); copy loop %.1f ns, to_array %.1f ns\n",
+               size, loop, many, from, release, copy_loop, to);
+        fflush(stdout);
+        free(data);
+        free(out);
+    }
+    return 0;
+}
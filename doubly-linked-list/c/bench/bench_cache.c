@@ -0,0 +1,91 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include <pthread.h>
+#include <stdio.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "../src/list.h"
+
+#define NODES 1000
+#define ROUNDS 1000
+#define MAX_THREADS 64
+
+static double now(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+static List *(*make)(Free free);
+static int remote;
+static int count;
+static List *lists[MAX_THREADS];
+static pthread_barrier_t barrier;
+
+static List *build(void) {
+    List *list = make(NULL);
+    for (int i = 0; i < NODES; i++) {
+        List_add_tail(list, NULL);
+    }
+    return list;
+}
+
+/*
+ * Every thread builds and tears down its own Lists, or with remote
+ * set, tears down the List its neighbour built in the same round
+ */
+static void *work(void *arg) {
+    int id = (int) (size_t) arg;
+    for (int round = 0; round < ROUNDS; round++) {
+        if (!remote) {
+            List_free(build());
+            continue;
+        }
+        lists[id] = build();
+        pthread_barrier_wait(&barrier);
+        List_free(lists[(id + 1) % count]);
+        pthread_barrier_wait(&barrier);
+    }
+    return NULL;
+}
+
+static double run(void) {
+    pthread_t threads[MAX_THREADS];
+    pthread_barrier_init(&barrier, NULL, count);
+    double start = now();
+    for (int i = 0; i < count; i++) {
+        pthread_create(&threads[i], NULL, work, (void *) (size_t) i);
+    }
+    for (int i = 0; i < count; i++) {
+        pthread_join(threads[i], NULL);
+    }
+    double elapsed = now() - start;
+    pthread_barrier_destroy(&barrier);
+    return count * 2.0 * NODES * ROUNDS / elapsed * 1e3;
+}
+
+/*
+ * Sweep thread counts up to the number of cores, at least 4,
+ * comparing Node allocation through calloc and free with the
+ * per thread caches, counting an allocation and a free per Node
+ */
+int main(void) {
+    long cores = sysconf(_SC_NPROCESSORS_ONLN);
+    int max = cores > 4 ? (int) cores : 4;
+    max = max > MAX_THREADS ? MAX_THREADS : max;
+
+    for (count = 1; count <= max; count *= 2) {
+        for (remote = 0; remote < 2; remote++) {
+            make = List_new;
+            double calloc_rate = run();
+            make = List_new_cached;
+            double cached_rate = run();
+
+            printf("%d threads, %s free: calloc %.2f Mops/s, cached %.2f Mops/s\n",
+                   count, remote ? "remote" : "local", calloc_rate, cached_rate);
+            fflush(stdout);
+        }
+    }
+    return 0;
+}
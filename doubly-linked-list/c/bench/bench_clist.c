@@ -0,0 +1,96 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include <pthread.h>
+#include <stdio.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "../src/clist.h"
+#include "../src/list.h"
+
+#define SIZE 100000
+#define OPS  500000
+
+static double now(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+static CList *clist;
+static CNode *cnodes[SIZE];
+static List *list;
+static Node *nodes[SIZE];
+static pthread_mutex_t lock = PTHREAD_MUTEX_INITIALIZER;
+static int threads;
+
+/*
+ * Every thread edits its own stretch of the list: insert
+ * after one of its Nodes, then delete the new Node again
+ */
+static void *clist_work(void *arg) {
+    size_t id = (size_t) arg;
+    size_t stretch = SIZE / threads;
+    CThread *thread = CList_register(clist);
+    for (size_t i = 0; i < OPS; i++) {
+        CNode *ref = cnodes[id * stretch + i % stretch];
+        CNode *node = CList_add_after(clist, thread, ref, NULL);
+        CList_delete(clist, thread, node);
+    }
+    CList_unregister(thread);
+    return NULL;
+}
+
+static void *list_work(void *arg) {
+    size_t id = (size_t) arg;
+    size_t stretch = SIZE / threads;
+    for (size_t i = 0; i < OPS; i++) {
+        Node *ref = nodes[id * stretch + i % stretch];
+        pthread_mutex_lock(&lock);
+        Node *node = List_add_after(list, ref, NULL);
+        List_delete(list, node);
+        pthread_mutex_unlock(&lock);
+    }
+    return NULL;
+}
+
+static double run(void *(*work)(void *)) {
+    pthread_t workers[threads];
+    double start = now();
+    for (int i = 0; i < threads; i++) {
+        pthread_create(&workers[i], NULL, work, (void *) (size_t) i);
+    }
+    for (int i = 0; i < threads; i++) {
+        pthread_join(workers[i], NULL);
+    }
+    return threads * 2.0 * OPS / (now() - start) * 1e3;
+}
+
+/*
+ * Sweep thread counts up to the number of cores, at least 4,
+ * comparing per CNode locking with a List behind one mutex
+ */
+int main(void) {
+    long cores = sysconf(_SC_NPROCESSORS_ONLN);
+    int max = cores > 4 ? (int) cores : 4;
+
+    clist = CList_new(NULL);
+    CThread *thread = CList_register(clist);
+    list = List_new(NULL);
+    for (int i = 0; i < SIZE; i++) {
+        cnodes[i] = CList_add_tail(clist, thread, NULL);
+        nodes[i] = List_add_tail(list, NULL);
+    }
+    CList_unregister(thread);
+
+    for (threads = 1; threads <= max; threads *= 2) {
+        double clist_rate = run(clist_work);
+        double list_rate = run(list_work);
+        printf("%d threads: CList %.2f Mops/s, mutex List %.2f Mops/s\n",
+               threads, clist_rate, list_rate);
+    }
+
+    CList_free(clist);
+    List_free(list);
+    return 0;
+}
@@ -0,0 +1,94 @@
+#define _POSIX_C_SOURCE 199309L
+
+#include <stdio.h>
+#include <time.h>
+
+#include "../src/list.h"
+
+#define STEP 4096
+
+static volatile size_t sink;
+
+static double now(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+static size_t random_next(size_t *state) {
+    size_t x = *state += 0x9e3779b97f4a7c15ULL;
+    x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+    return x ^ (x >> 31);
+}
+
+/*
+ * List whose link order is random with respect to where
+ * its Nodes sit in the heap or Pool, as after long churn
+ */
+static List *scatter(size_t size, int pooled) {
+    List *list = List_new(NULL);
+    if (pooled) {
+        Pool *pool = Pool_new(sizeof(Node), 4096);
+        List_free(list);
+        list = List_new_pooled(NULL, pool);
+        Pool_free(pool);
+    }
+    Node **nodes = malloc(size * sizeof(Node *));
+    for (size_t i = 0; i < size; i++) {
+        nodes[i] = List_add_tail(list, (void *) i);
+    }
+
+    size_t state = 1;
+    for (size_t i = size - 1; i > 0; i--) {
+        size_t j = random_next(&state) % (i + 1);
+        if (i != j) {
+            List_swap(list, nodes[i], nodes[j]);
+        }
+    }
+    free(nodes);
+    return list;
+}
+
+static double walk(List *list) {
+    double start = now();
+    size_t sum = 0;
+    for (Node *node = list->head; node; node = node->next) {
+        sum += (size_t) node->data;
+    }
+    sink = sum;
+    return (now() - start) / list->size;
+}
+
+/*
+ * Scan times of scattered Lists before and after compacting them
+ * at once, and with List_compact_range in steps of STEP Nodes
+ */
+int main(int argc, char *argv[]) {
+    size_t max = argc > 1 ? strtoul(argv[1], NULL, 10) : 10000000;
+
+    for (size_t size = 10000; size <= max; size *= 10) {
+        List *list = scatter(size, 0);
+        double before = walk(list);
+        double start = now();
+        List_compact(list, NULL, NULL);
+        double whole = (now() - start) / size;
+        double after = walk(list);
+        List_free(list);
+
+        list = scatter(size, 1);
+        double pooled = walk(list);
+        start = now();
+        Node *next = list->head;
+        while ((next = List_compact_range(list, next, STEP, NULL, NULL)));
+        double stepped = (now() - start) / size;
+        double after_steps = walk(list);
+        List_free(list);
+
+        printf("%zu: scan %.1f ns scattered, %.1f ns compacted (%.1f ns/node); "
+               "pooled %.1f ns scattered, %.1f ns after steps of %d (%.1f ns/node)\n",
+               size, before, after, whole, pooled, after_steps, STEP, stepped);
+        fflush(stdout);
+    }
+    return 0;
+}
@@ -0,0 +1,109 @@
+#define _POSIX_C_SOURCE 199309L
+
+#include <stdint.h>
+#include <stdio.h>
+#include <time.h>
+
+#include "../src/list.h"
+
+#define QUADRATIC 10000
+
+static double now(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+static int is_tenth(void *data, void *arg) {
+    (void) arg;
+    return (uintptr_t) data % 10 == 0;
+}
+
+static size_t hash(const void *data) {
+    return (uintptr_t) data * 0x9e3779b97f4a7c15ULL;
+}
+
+static int compare(const void *a, const void *b) {
+    return (a > b) - (a < b);
+}
+
+/*
+ * Values 1..size, with only size / 2 distinct ones, in a pooled
+ * List so timings do not depend on the state of the heap
+ */
+static List *fill(size_t size) {
+    Pool *pool = Pool_new(sizeof(Node), 4096);
+    List *list = List_new_pooled(NULL, pool);
+    Pool_free(pool);
+    for (size_t i = 0; i < size; i++) {
+        List_add_tail(list, (void *) (i % (size / 2) + 1));
+    }
+    return list;
+}
+
+/*
+ * Delete by index as callers did before List_delete_if, kept
+ * linear by the cursor List_get_at leaves on the last Node
+ */
+static void delete_at_loop(List *list) {
+    for (int i = 0; i < (int) list->size; ) {
+        if (is_tenth(List_get_at(list, i)->data, NULL)) {
+            List_delete_at(list, i);
+        } else {
+            i++;
+        }
+    }
+}
+
+/*
+ * Remove duplicates comparing every pair
+ */
+static void unique_pairs(List *list) {
+    for (Node *node = list->head; node; node = node->next) {
+        Node *other = node->next;
+        while (other) {
+            Node *next = other->next;
+            if (other->data == node->data) {
+                List_delete(list, other);
+            }
+            other = next;
+        }
+    }
+}
+
+static double measure(void (*run)(List *list), size_t size) {
+    List *list = fill(size);
+    double start = now();
+    run(list);
+    double elapsed = (now() - start) / size;
+    List_free(list);
+    return elapsed;
+}
+
+static void delete_if(List *list) {
+    List_delete_if(list, is_tenth, NULL);
+}
+
+static void unique(List *list) {
+    List_unique(list, hash, compare);
+}
+
+/*
+ * Purge a tenth of a List and remove duplicates from it, one pass
+ * against the per element loops, pairwise only up to QUADRATIC
+ */
+int main(int argc, char *argv[]) {
+    size_t max = argc > 1 ? strtoul(argv[1], NULL, 10) : 10000000;
+
+    for (size_t size = 1000; size <= max; size *= 10) {
+        printf("%zu: delete_if %.1f ns, delete_at loop %.1f ns",
+               size, measure(delete_if, size), measure(delete_at_loop, size));
+        printf("; unique %.1f ns", measure(unique, size));
+        if (size <= QUADRATIC) {
+            printf(", pairwise %.1f ns", measure(unique_pairs, size));
+        }
+        printf(" per element\n");
+        fflush(stdout);
+    }
+    return 0;
+}
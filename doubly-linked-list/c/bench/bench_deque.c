@@ -0,0 +1,86 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include <pthread.h>
+#include <stdio.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "../src/deque.h"
+#include "../src/list.h"
+
+#define OPS 1000000
+
+static double now(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+static Deque *deque;
+static List *list;
+static pthread_mutex_t lock = PTHREAD_MUTEX_INITIALIZER;
+
+/*
+ * Work queue pattern: every thread adds at the tail
+ * and takes from the head
+ */
+static void *deque_work(void *arg) {
+    EpochThread *thread = Deque_register(deque);
+    void *data;
+    for (int i = 0; i < OPS; i++) {
+        Deque_add_tail(deque, thread, arg);
+        Deque_pop_head(deque, thread, &data);
+    }
+    Deque_unregister(thread);
+    return NULL;
+}
+
+static void *list_work(void *arg) {
+    for (int i = 0; i < OPS; i++) {
+        pthread_mutex_lock(&lock);
+        List_add_tail(list, arg);
+        pthread_mutex_unlock(&lock);
+
+        pthread_mutex_lock(&lock);
+        if (list->head) {
+            List_delete(list, list->head);
+        }
+        pthread_mutex_unlock(&lock);
+    }
+    return NULL;
+}
+
+static double run(void *(*work)(void *), int count) {
+    pthread_t threads[count];
+    double start = now();
+    for (int i = 0; i < count; i++) {
+        pthread_create(&threads[i], NULL, work, NULL);
+    }
+    for (int i = 0; i < count; i++) {
+        pthread_join(threads[i], NULL);
+    }
+    return count * 2.0 * OPS / (now() - start) * 1e3;
+}
+
+/*
+ * Sweep thread counts up to the number of cores, at least 4,
+ * comparing the lock-free Deque with a List behind a mutex
+ */
+int main(void) {
+    long cores = sysconf(_SC_NPROCESSORS_ONLN);
+    int max = cores > 4 ? (int) cores : 4;
+
+    for (int count = 1; count <= max; count *= 2) {
+        deque = Deque_new(NULL);
+        double deque_rate = run(deque_work, count);
+        Deque_free(deque);
+
+        list = List_new(NULL);
+        double list_rate = run(list_work, count);
+        List_free(list);
+
+        printf("%d threads: Deque %.2f Mops/s, mutex List %.2f Mops/s\n",
+               count, deque_rate, list_rate);
+    }
+    return 0;
+}
@@ -0,0 +1,143 @@
+#define _POSIX_C_SOURCE 199309L
+
+#include <stdint.h>
+#include <stdio.h>
+#include <time.h>
+
+#include "../src/list.h"
+
+static volatile long sink;
+static int rounds;
+
+static double now(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+static size_t random_next(size_t *state) {
+    size_t x = *state += 0x9e3779b97f4a7c15ULL;
+    x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+    return x ^ (x >> 31);
+}
+
+/*
+ * List whose link order and data addresses are both random
+ * with respect to where Nodes and payloads sit in the heap
+ */
+static List *scatter(size_t size) {
+    List *list = List_new(free);
+    Node **nodes = malloc(size * sizeof(Node *));
+    for (size_t i = 0; i < size; i++) {
+        int *value = malloc(sizeof(int));
+        *value = (int) i;
+        nodes[i] = List_add_tail(list, value);
+    }
+
+    size_t state = 1;
+    for (size_t i = size - 1; i > 0; i--) {
+        size_t j = random_next(&state) % (i + 1);
+        if (i != j) {
+            List_swap(list, nodes[i], nodes[j]);
+        }
+        void *data = nodes[i]->data;
+        nodes[i]->data = nodes[j]->data;
+        nodes[j]->data = data;
+    }
+    free(nodes);
+    return list;
+}
+
+/*
+ * Per element work, rounds of mixing standing in for parsing
+ * or scoring, during which the iterator's loads are in flight
+ */
+static long value(void *data) {
+    uint64_t x = *(int *) data;
+    for (int i = 0; i < rounds; i++) {
+        x ^= x >> 30;
+        x *= 0xbf58476d1ce4e5b9ULL;
+    }
+    return (long) (x & 0xff);
+}
+
+static void add(void *data, void *arg) {
+    *(long *) arg += value(data);
+}
+
+static long naive(List *list) {
+    long sum = 0;
+    for (Node *node = list->head; node; node = node->next) {
+        sum += value(node->data);
+    }
+    return sum;
+}
+
+static long iterate(List *list, int flags) {
+    long sum = 0;
+    ListIter iter;
+    List_iter(&iter, list, flags);
+    Node *node;
+    while ((node = List_iter_next(&iter))) {
+        sum += value(node->data);
+    }
+    return sum;
+}
+
+static long foreach(List *list, int flags) {
+    long sum = 0;
+    List_foreach(list, add, &sum, flags);
+    return sum;
+}
+
+/*
+ * Time every way of walking the List once, per element
+ */
+static void measure(List *list, size_t size) {
+    double times[5];
+
+    double start = now();
+    sink = naive(list);
+    times[0] = now() - start;
+
+    start = now();
+    sink = iterate(list, LIST_FORWARD);
+    times[1] = now() - start;
+
+    start = now();
+    sink = iterate(list, LIST_PREFETCH_DATA);
+    times[2] = now() - start;
+
+    start = now();
+    sink = iterate(list, LIST_BACKWARD | LIST_PREFETCH_DATA);
+    times[3] = now() - start;
+
+    start = now();
+    sink = foreach(list, LIST_PREFETCH_DATA);
+    times[4] = now() - start;
+
+    printf("%zu, %d rounds: naive %.1f ns, iter %.1f ns, iter+data %.1f ns, "
+           "backward+data %.1f ns, foreach+data %.1f ns\n",
+           size, rounds, times[0] / size, times[1] / size, times[2] / size,
+           times[3] / size, times[4] / size);
+    fflush(stdout);
+}
+
+/*
+ * Sum the ints of scattered Lists with the naive next loop
+ * of List_get_index and with the prefetching iterators, with
+ * no work per element and with about 100 ns of it
+ */
+int main(int argc, char *argv[]) {
+    size_t max = argc > 1 ? strtoul(argv[1], NULL, 10) : 10000000;
+
+    for (size_t size = 10000; size <= max; size *= 10) {
+        List *list = scatter(size);
+        for (rounds = 0; rounds <= 100; rounds += 100) {
+            measure(list, size);
+        }
+        List_free(list);
+    }
+    return 0;
+}
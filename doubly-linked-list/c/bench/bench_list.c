@@ -0,0 +1,366 @@
+#define _POSIX_C_SOURCE 199309L
+
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+#include "../src/list.h"
+
+#define MIN_SIZE 100
+#define MAX_SIZE 10000000
+
+/*
+ * Node steps allowed for a benchmark whose operations cost O(n),
+ * so large sizes run fewer of them instead of running for hours
+ */
+#define WORK 100000000
+
+static size_t allocs;
+static volatile size_t sink;
+
+/*
+ * Allocator hooks, the makefile builds this bench with
+ * LIST_MALLOC, LIST_CALLOC and LIST_FREE pointing here
+ */
+void *bench_malloc(size_t size) {
+    allocs++;
+    return malloc(size);
+}
+
+void *bench_calloc(size_t count, size_t size) {
+    allocs++;
+    return calloc(count, size);
+}
+
+void bench_free(void *ptr) {
+    free(ptr);
+}
+
+static double now(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+static size_t random_next(size_t *state) {
+    size_t x = *state += 0x9e3779b97f4a7c15ULL;
+    x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+    return x ^ (x >> 31);
+}
+
+/*
+ * Growable array of pointers, the baseline every List operation
+ * is compared against
+ */
+typedef struct {
+    void **items;
+    size_t size;
+    size_t capacity;
+} Array;
+
+static void Array_reserve(Array *array, size_t size) {
+    if (size <= array->capacity) {
+        return;
+    }
+    while (array->capacity < size) {
+        array->capacity = array->capacity ? array->capacity * 2 : 16;
+    }
+    array->items = realloc(array->items, array->capacity * sizeof(void *));
+    allocs++;
+}
+
+static void Array_insert(Array *array, size_t index, void *data) {
+    Array_reserve(array, array->size + 1);
+    memmove(array->items + index + 1, array->items + index,
+            (array->size - index) * sizeof(void *));
+    array->items[index] = data;
+    array->size++;
+}
+
+/*
+ * State shared by a benchmark run: the containers, filled with
+ * size items beforehand, and the access pattern
+ */
+typedef struct {
+    List *list;
+    Array array;
+    Node **nodes;
+    size_t *indexes;
+    size_t size;
+    size_t ops;
+} Fixture;
+
+typedef size_t (*Run)(Fixture *fixture);
+
+enum { NEVER, RANDOM, ALWAYS };
+
+enum { LIST, POOLED, ARRAY };
+
+static const char *containers[] = { "list", "pooled", "array" };
+
+static const char *patterns[] = { "sequential", "random" };
+
+typedef struct {
+    const char *name;
+    int container;
+    int linear;    /* when operations cost O(n) */
+    int patterned; /* whether the access pattern matters */
+    Run run;
+} Bench;
+
+static size_t list_add_tail(Fixture *f) {
+    for (size_t i = 0; i < f->ops; i++) {
+        List_add_tail(f->list, NULL);
+    }
+    return f->ops;
+}
+
+static size_t array_add_tail(Fixture *f) {
+    for (size_t i = 0; i < f->ops; i++) {
+        Array_insert(&f->array, f->array.size, NULL);
+    }
+    return f->ops;
+}
+
+static size_t list_add_head(Fixture *f) {
+    for (size_t i = 0; i < f->ops; i++) {
+        List_add_head(f->list, NULL);
+    }
+    return f->ops;
+}
+
+static size_t array_add_head(Fixture *f) {
+    for (size_t i = 0; i < f->ops; i++) {
+        Array_insert(&f->array, 0, NULL);
+    }
+    return f->ops;
+}
+
+static size_t list_add_at(Fixture *f) {
+    for (size_t i = 0; i < f->ops; i++) {
+        List_add_at(f->list, f->indexes[i] % f->list->size, NULL);
+    }
+    return f->ops;
+}
+
+static size_t array_add_at(Fixture *f) {
+    for (size_t i = 0; i < f->ops; i++) {
+        Array_insert(&f->array, f->indexes[i] % f->array.size, NULL);
+    }
+    return f->ops;
+}
+
+static size_t list_get_at(Fixture *f) {
+    for (size_t i = 0; i < f->ops; i++) {
+        sink = (size_t) List_get_at(f->list, f->indexes[i])->data;
+    }
+    return f->ops;
+}
+
+static size_t array_get_at(Fixture *f) {
+    for (size_t i = 0; i < f->ops; i++) {
+        sink = (size_t) f->array.items[f->indexes[i]];
+    }
+    return f->ops;
+}
+
+static size_t list_get_index(Fixture *f) {
+    for (size_t i = 0; i < f->ops; i++) {
+        sink = List_get_index(f->list, f->nodes[f->indexes[i]]);
+    }
+    return f->ops;
+}
+
+static size_t array_get_index(Fixture *f) {
+    for (size_t i = 0; i < f->ops; i++) {
+        void *data = f->array.items[f->indexes[i]];
+        size_t index = 0;
+        while (f->array.items[index] != data) {
+            index++;
+        }
+        sink = index;
+    }
+    return f->ops;
+}
+
+static size_t list_swap(Fixture *f) {
+    for (size_t i = 0; i < f->ops; i++) {
+        size_t a = f->indexes[i];
+        size_t b = f->indexes[(i + 1) % f->ops];
+        if (a != b) {
+            List_swap(f->list, f->nodes[a], f->nodes[b]);
+        }
+    }
+    return f->ops;
+}
+
+static size_t array_swap(Fixture *f) {
+    for (size_t i = 0; i < f->ops; i++) {
+        size_t a = f->indexes[i];
+        size_t b = f->indexes[(i + 1) % f->ops];
+        void *item = f->array.items[a];
+        f->array.items[a] = f->array.items[b];
+        f->array.items[b] = item;
+    }
+    return f->ops;
+}
+
+static size_t list_delete_at(Fixture *f) {
+    for (size_t i = 0; i < f->ops; i++) {
+        List_delete_at(f->list, f->indexes[i] % f->list->size);
+    }
+    return f->ops;
+}
+
+static size_t array_delete_at(Fixture *f) {
+    for (size_t i = 0; i < f->ops; i++) {
+        size_t index = f->indexes[i] % f->array.size;
+        f->array.size--;
+        memmove(f->array.items + index, f->array.items + index + 1,
+                (f->array.size - index) * sizeof(void *));
+    }
+    return f->ops;
+}
+
+static size_t list_reverse(Fixture *f) {
+    for (size_t i = 0; i < f->ops; i++) {
+        List_reverse(f->list);
+    }
+    return f->ops;
+}
+
+static size_t array_reverse(Fixture *f) {
+    for (size_t i = 0; i < f->ops; i++) {
+        void **a = f->array.items;
+        void **b = f->array.items + f->array.size - 1;
+        for (; a < b; a++, b--) {
+            void *item = *a;
+            *a = *b;
+            *b = item;
+        }
+    }
+    return f->ops;
+}
+
+/*
+ * Clearing is one call, reported per item cleared
+ */
+static size_t list_clear(Fixture *f) {
+    size_t size = f->list->size;
+    List_clear(f->list);
+    return size;
+}
+
+static size_t array_clear(Fixture *f) {
+    size_t size = f->array.size;
+    free(f->array.items);
+    f->array.items = NULL;
+    f->array.size = 0;
+    f->array.capacity = 0;
+    return size;
+}
+
+static const Bench benches[] = {
+    { "add_tail",  LIST,   NEVER,  0, list_add_tail },
+    { "add_tail",  POOLED, NEVER,  0, list_add_tail },
+    { "add_tail",  ARRAY,  NEVER,  0, array_add_tail },
+    { "add_head",  LIST,   NEVER,  0, list_add_head },
+    { "add_head",  POOLED, NEVER,  0, list_add_head },
+    { "add_head",  ARRAY,  ALWAYS, 0, array_add_head },
+    { "add_at",    LIST,   RANDOM, 1, list_add_at },
+    { "add_at",    POOLED, RANDOM, 1, list_add_at },
+    { "add_at",    ARRAY,  ALWAYS, 1, array_add_at },
+    { "get_at",    LIST,   RANDOM, 1, list_get_at },
+    { "get_at",    ARRAY,  NEVER,  1, array_get_at },
+    { "get_index", LIST,   ALWAYS, 1, list_get_index },
+    { "get_index", ARRAY,  ALWAYS, 1, array_get_index },
+    { "swap",      LIST,   NEVER,  1, list_swap },
+    { "swap",      ARRAY,  NEVER,  1, array_swap },
+    { "delete_at", LIST,   RANDOM, 1, list_delete_at },
+    { "delete_at", POOLED, RANDOM, 1, list_delete_at },
+    { "delete_at", ARRAY,  ALWAYS, 1, array_delete_at },
+    { "reverse",   LIST,   ALWAYS, 0, list_reverse },
+    { "reverse",   ARRAY,  ALWAYS, 0, array_reverse },
+    { "clear",     LIST,   NEVER,  0, list_clear },
+    { "clear",     POOLED, NEVER,  0, list_clear },
+    { "clear",     ARRAY,  NEVER,  0, array_clear },
+};
+
+/*
+ * Fill the container, run the benchmark once and print a CSV row
+ */
+static void measure(const Bench *bench, int pattern, size_t size, size_t *indexes) {
+    Fixture f = { 0 };
+    f.size = size;
+    f.indexes = indexes;
+
+    int linear = bench->linear == ALWAYS || (bench->linear == RANDOM && pattern);
+    f.ops = linear ? WORK / size : size;
+    f.ops = f.ops < 1 ? 1 : f.ops > size ? size : f.ops;
+
+    if (bench->container == ARRAY) {
+        Array_reserve(&f.array, size);
+        for (size_t i = 0; i < size; i++) {
+            f.array.items[i] = (void *) (i + 1);
+        }
+        f.array.size = size;
+    } else {
+        if (bench->container == POOLED) {
+            Pool *pool = Pool_new(sizeof(Node), 4096);
+            f.list = List_new_pooled(NULL, pool);
+            Pool_free(pool);
+        } else {
+            f.list = List_new(NULL);
+        }
+        f.nodes = malloc(size * sizeof(Node *));
+        for (size_t i = 0; i < size; i++) {
+            f.nodes[i] = List_add_tail(f.list, (void *) (i + 1));
+        }
+    }
+
+    allocs = 0;
+    double start = now();
+    size_t ops = bench->run(&f);
+    double elapsed = now() - start;
+
+    printf("%s,%s,%s,%zu,%zu,%.2f,%.0f,%.4g\n",
+           bench->name, patterns[pattern], containers[bench->container], size, ops,
+           elapsed / ops, ops / elapsed * 1e9, (double) allocs / ops);
+    fflush(stdout);
+
+    if (f.list) {
+        List_free(f.list);
+    }
+    free(f.nodes);
+    free(f.array.items);
+}
+
+/*
+ * Sweep sizes by powers of ten up to MAX_SIZE, or the size given,
+ * printing one CSV row per operation, pattern, container and size
+ */
+int main(int argc, char *argv[]) {
+    size_t max = argc > 1 ? strtoul(argv[1], NULL, 10) : MAX_SIZE;
+
+    printf("operation,pattern,container,size,ops,ns_per_op,ops_per_sec,allocs_per_op\n");
+    for (size_t size = MIN_SIZE; size <= max; size *= 10) {
+        size_t *indexes = malloc(size * sizeof(size_t));
+
+        for (int pattern = 0; pattern < 2; pattern++) {
+            size_t state = 1;
+            for (size_t i = 0; i < size; i++) {
+                indexes[i] = pattern ? random_next(&state) % size : i;
+            }
+            for (size_t b = 0; b < sizeof(benches) / sizeof(benches[0]); b++) {
+                if (pattern && !benches[b].patterned) {
+                    continue;
+                }
+                measure(&benches[b], pattern, size, indexes);
+            }
+        }
+
+        free(indexes);
+    }
+    return 0;
+}
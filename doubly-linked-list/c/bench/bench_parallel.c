@@ -0,0 +1,70 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdint.h>
+#include <stdio.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "../src/parallel.h"
+
+#define SIZE 200000
+#define WORK 500
+
+static double now(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+/*
+ * CPU-bound stand-in for parsing or scoring an element
+ */
+static void *score(void *acc, void *data) {
+    uint64_t x = (uintptr_t) data;
+    for (int i = 0; i < WORK; i++) {
+        x ^= x >> 30;
+        x *= 0xbf58476d1ce4e5b9ULL;
+    }
+    return (void *) ((uintptr_t) acc + (x & 1));
+}
+
+static void *sum(void *acc, void *data) {
+    return (void *) ((uintptr_t) acc + (uintptr_t) data);
+}
+
+/*
+ * Sweep thread counts up to the number of cores, at least 4,
+ * with a heavy and a trivial reduce, speedups against 1 thread
+ */
+int main(void) {
+    long cores = sysconf(_SC_NPROCESSORS_ONLN);
+    int max = cores > 4 ? (int) cores : 4;
+    max = max > PARALLEL_MAX ? PARALLEL_MAX : max;
+
+    List *list = List_new(NULL);
+    for (uintptr_t i = 0; i < SIZE; i++) {
+        List_add_tail(list, (void *) i);
+    }
+
+    double heavy_base = 0, light_base = 0;
+    for (int threads = 1; threads <= max; threads *= 2) {
+        double start = now();
+        List_parallel_reduce(list, score, sum, NULL, threads);
+        double heavy = now() - start;
+
+        start = now();
+        List_parallel_reduce(list, sum, sum, NULL, threads);
+        double light = now() - start;
+
+        if (threads == 1) {
+            heavy_base = heavy;
+            light_base = light;
+        }
+        printf("%d threads: heavy %.1f ms (%.2fx), trivial %.2f ms (%.2fx)\n",
+               threads, heavy / 1e6, heavy_base / heavy, light / 1e6, light_base / light);
+        fflush(stdout);
+    }
+
+    List_free(list);
+    return 0;
+}
@@ -0,0 +1,52 @@
+#define _POSIX_C_SOURCE 199309L
+
+#include <stdio.h>
+#include <time.h>
+
+#include "../src/list.h"
+
+#define SIZE   100000
+#define ROUNDS 50
+
+static double now(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+static void noop(void *data) {
+    (void) data;
+}
+
+/*
+ * Fill the List, then churn it by deleting the head and
+ * adding a new tail, which is one free and one alloc per step
+ */
+static double churn(List *list) {
+    double start = now();
+    for (int i = 0; i < SIZE; i++) {
+        List_add_tail(list, NULL);
+    }
+    for (int r = 0; r < ROUNDS; r++) {
+        for (int i = 0; i < SIZE; i++) {
+            List_delete(list, list->head);
+            List_add_tail(list, NULL);
+        }
+    }
+    List_clear(list);
+    return (now() - start) / (SIZE * (ROUNDS * 2 + 2));
+}
+
+int main(void) {
+    List *list = List_new(noop);
+    printf("calloc: %.2f ns/op\n", churn(list));
+    List_free(list);
+
+    Pool *pool = Pool_new(sizeof(Node), 4096);
+    list = List_new_pooled(noop, pool);
+    printf("pooled: %.2f ns/op\n", churn(list));
+    List_free(list);
+    Pool_free(pool);
+
+    return 0;
+}
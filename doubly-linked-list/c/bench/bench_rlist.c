@@ -0,0 +1,142 @@
+#define _GNU_SOURCE
+
+#include <pthread.h>
+#include <stdio.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "../src/list.h"
+#include "../src/rlist.h"
+
+#define SIZE     1000
+#define DURATION 0.5e9
+
+static double now(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+static RList *rlist;
+static List *list;
+static pthread_rwlock_t lock;
+static atomic_int done;
+static atomic_size_t lookups;
+static volatile size_t sink;
+
+/*
+ * Readers look a table up by walking it end to end
+ */
+static void *rlist_read(void *arg) {
+    (void) arg;
+    EpochThread *thread = RList_register(rlist);
+    size_t count = 0;
+    while (!atomic_load_explicit(&done, memory_order_relaxed)) {
+        RList_read_lock(thread);
+        size_t sum = 0;
+        for (RNode *node = RList_first(rlist); node; node = RList_next(node)) {
+            sum += (size_t) node->data;
+        }
+        RList_read_unlock(thread);
+        sink = sum;
+        count++;
+    }
+    RList_unregister(thread);
+    atomic_fetch_add(&lookups, count);
+    return NULL;
+}
+
+static void *list_read(void *arg) {
+    (void) arg;
+    size_t count = 0;
+    while (!atomic_load_explicit(&done, memory_order_relaxed)) {
+        pthread_rwlock_rdlock(&lock);
+        size_t sum = 0;
+        for (Node *node = list->head; node; node = node->next) {
+            sum += (size_t) node->data;
+        }
+        pthread_rwlock_unlock(&lock);
+        sink = sum;
+        count++;
+    }
+    atomic_fetch_add(&lookups, count);
+    return NULL;
+}
+
+/*
+ * The writer updates one entry every millisecond until deadline
+ */
+static void rlist_write(RNode *nodes[], double deadline) {
+    struct timespec pause = { 0, 1000000 };
+    for (size_t i = 0; now() < deadline; i++) {
+        nodes[i % SIZE] = RList_replace(rlist, nodes[i % SIZE], (void *) i);
+        nanosleep(&pause, NULL);
+    }
+}
+
+static void list_write(Node *nodes[], double deadline) {
+    struct timespec pause = { 0, 1000000 };
+    for (size_t i = 0; now() < deadline; i++) {
+        pthread_rwlock_wrlock(&lock);
+        nodes[i % SIZE]->data = (void *) i;
+        pthread_rwlock_unlock(&lock);
+        nanosleep(&pause, NULL);
+    }
+}
+
+static double run(int readers, int rcu, RNode *rnodes[], Node *nodes[]) {
+    pthread_t threads[readers];
+    atomic_store(&done, 0);
+    atomic_store(&lookups, 0);
+
+    double start = now();
+    for (int i = 0; i < readers; i++) {
+        pthread_create(&threads[i], NULL, rcu ? rlist_read : list_read, NULL);
+    }
+    if (rcu) {
+        rlist_write(rnodes, start + DURATION);
+    } else {
+        list_write(nodes, start + DURATION);
+    }
+    atomic_store(&done, 1);
+    for (int i = 0; i < readers; i++) {
+        pthread_join(threads[i], NULL);
+    }
+    return atomic_load(&lookups) / (now() - start) * 1e3;
+}
+
+/*
+ * Sweep reader counts up to the number of cores, at least 4,
+ * comparing RList readers with a List behind a rwlock that
+ * lets the writer in ahead of new readers
+ */
+int main(void) {
+    long cores = sysconf(_SC_NPROCESSORS_ONLN);
+    int max = cores > 4 ? (int) cores : 4;
+
+    pthread_rwlockattr_t attr;
+    pthread_rwlockattr_init(&attr);
+    pthread_rwlockattr_setkind_np(&attr, PTHREAD_RWLOCK_PREFER_WRITER_NONRECURSIVE_NP);
+    pthread_rwlock_init(&lock, &attr);
+
+    static RNode *rnodes[SIZE];
+    static Node *nodes[SIZE];
+    rlist = RList_new(NULL);
+    list = List_new(NULL);
+    for (size_t i = 0; i < SIZE; i++) {
+        rnodes[i] = RList_add_tail(rlist, (void *) i);
+        nodes[i] = List_add_tail(list, (void *) i);
+    }
+
+    for (int readers = 1; readers <= max; readers *= 2) {
+        double rlist_rate = run(readers, 1, rnodes, nodes);
+        double list_rate = run(readers, 0, rnodes, nodes);
+        printf("%d readers: RList %.3f M walks/s, rwlock List %.3f M walks/s\n",
+               readers, rlist_rate, list_rate);
+        fflush(stdout);
+    }
+
+    RList_free(rlist);
+    List_free(list);
+    return 0;
+}
@@ -0,0 +1,88 @@
+#define _POSIX_C_SOURCE 199309L
+
+#include <stdio.h>
+#include <time.h>
+
+#include "../src/list.h"
+
+static double now(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+static int compare(const void *a, const void *b) {
+    int x = *(const int *) a;
+    int y = *(const int *) b;
+    return (x > y) - (x < y);
+}
+
+static int compare_pointers(const void *a, const void *b) {
+    return compare(*(void * const *) a, *(void * const *) b);
+}
+
+/*
+ * Sort by copying data out to an array, sorting it and
+ * rebuilding the List, as callers had to before List_sort
+ */
+static void array_sort(List *list) {
+    size_t size = list->size;
+    void **items = malloc(size * sizeof(void *));
+    size_t i = 0;
+    for (Node *node = list->head; node; node = node->next) {
+        items[i++] = node->data;
+    }
+    qsort(items, size, sizeof(void *), compare_pointers);
+    List_clear(list);
+    for (i = 0; i < size; i++) {
+        List_add_tail(list, items[i]);
+    }
+    free(items);
+}
+
+/*
+ * Build a fresh pooled List, so every run starts with Nodes laid
+ * out in list order whatever the previous run left in the heap
+ */
+static List *fill(int *values, size_t size, int sorted) {
+    Pool *pool = Pool_new(sizeof(Node), 4096);
+    List *list = List_new_pooled(NULL, pool);
+    Pool_free(pool);
+
+    srand(1);
+    for (size_t i = 0; i < size; i++) {
+        values[i] = sorted && i % 100 ? (int) i : rand();
+        List_add_tail(list, &values[i]);
+    }
+    return list;
+}
+
+int main(int argc, char *argv[]) {
+    size_t sizes[] = { 1000000, 5000000 };
+    size_t count = argc > 1 ? (size_t) argc - 1 : sizeof(sizes) / sizeof(sizes[0]);
+
+    for (size_t s = 0; s < count; s++) {
+        size_t size = argc > 1 ? strtoul(argv[s + 1], NULL, 10) : sizes[s];
+        int *values = malloc(size * sizeof(int));
+
+        for (int sorted = 0; sorted < 2; sorted++) {
+            List *list = fill(values, size, sorted);
+            double start = now();
+            List_sort(list, compare);
+            double list_time = (now() - start) / 1e6;
+            List_free(list);
+
+            list = fill(values, size, sorted);
+            start = now();
+            array_sort(list);
+            double array_time = (now() - start) / 1e6;
+            List_free(list);
+
+            printf("%zu %s: List_sort %.1f ms, array round-trip %.1f ms\n",
+                   size, sorted ? "nearly sorted" : "random", list_time, array_time);
+        }
+
+        free(values);
+    }
+    return 0;
+}
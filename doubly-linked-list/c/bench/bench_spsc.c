@@ -0,0 +1,115 @@
+#define _GNU_SOURCE
+
+#include <pthread.h>
+#include <sched.h>
+#include <stdio.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "../src/list.h"
+#include "../src/spsc.h"
+
+#define ITEMS    20000000
+#define CAPACITY 1024
+
+static double now(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+/*
+ * Pin the calling thread to a core, wrapping around when
+ * the machine has fewer. Both sides yield instead of spinning
+ * when stuck, so sharing one core still makes progress
+ */
+static void pin(int core) {
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(core % sysconf(_SC_NPROCESSORS_ONLN), &set);
+    pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+}
+
+static Spsc *queue;
+static List *list;
+static pthread_mutex_t lock = PTHREAD_MUTEX_INITIALIZER;
+static size_t batch;
+
+static void *spsc_produce(void *arg) {
+    (void) arg;
+    void *items[64] = { 0 };
+    pin(1);
+    for (size_t sent = 0; sent < ITEMS;) {
+        size_t count = ITEMS - sent < batch ? ITEMS - sent : batch;
+        size_t pushed = Spsc_push_many(queue, items, count);
+        if (!pushed) {
+            sched_yield();
+        }
+        sent += pushed;
+    }
+    return NULL;
+}
+
+static void spsc_consume(void) {
+    void *items[64];
+    for (size_t received = 0; received < ITEMS;) {
+        size_t popped = Spsc_pop_many(queue, items, batch);
+        if (!popped) {
+            sched_yield();
+        }
+        received += popped;
+    }
+}
+
+static void *list_produce(void *arg) {
+    (void) arg;
+    pin(1);
+    for (size_t sent = 0; sent < ITEMS; sent++) {
+        pthread_mutex_lock(&lock);
+        List_add_tail(list, NULL);
+        pthread_mutex_unlock(&lock);
+    }
+    return NULL;
+}
+
+static void list_consume(void) {
+    for (size_t received = 0; received < ITEMS;) {
+        pthread_mutex_lock(&lock);
+        if (list->head) {
+            List_delete(list, list->head);
+            received++;
+        }
+        pthread_mutex_unlock(&lock);
+    }
+}
+
+static double run(void *(*produce)(void *), void (*consume)(void)) {
+    pthread_t producer;
+    double start = now();
+    pthread_create(&producer, NULL, produce, NULL);
+    consume();
+    pthread_join(producer, NULL);
+    return ITEMS / (now() - start) * 1e3;
+}
+
+/*
+ * Move ITEMS elements between two pinned threads, one by one and
+ * in batches, against a List behind a mutex
+ */
+int main(void) {
+    pin(0);
+
+    size_t batches[] = { 1, 16, 64 };
+    for (size_t b = 0; b < sizeof(batches) / sizeof(batches[0]); b++) {
+        batch = batches[b];
+        queue = Spsc_new(CAPACITY, NULL);
+        printf("Spsc batch %zu: %.2f Mops/s\n", batch, run(spsc_produce, spsc_consume));
+        Spsc_free(queue);
+    }
+
+    list = List_new(NULL);
+    printf("mutex List: %.2f Mops/s\n", run(list_produce, list_consume));
+    List_free(list);
+
+    return 0;
+}
@@ -0,0 +1,146 @@
+#define _GNU_SOURCE
+
+#include <malloc.h>
+#include <stdio.h>
+#include <time.h>
+
+#include "../src/list.h"
+#include "../src/tlist.h"
+
+typedef struct {
+    double x, y, z;
+} Point;
+
+LIST_DEFINE(IntList, int, LIST_TRIVIAL)
+LIST_DEFINE(PointList, Point, LIST_TRIVIAL)
+
+static volatile double sink;
+
+static double now(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+static size_t heap(void) {
+    struct mallinfo2 info = mallinfo2();
+    return info.uordblks + info.hblkhd;
+}
+
+static void report(const char *name, size_t size, size_t bytes, double times[3]) {
+    printf("%s %zu: %.1f bytes/element, add_tail %.1f ns, sum %.1f ns, clear %.1f ns\n",
+           name, size, (double) bytes / size,
+           times[0] / size, times[1] / size, times[2] / size);
+}
+
+/*
+ * Payload behind void *data, one extra allocation per element
+ */
+static void bench_list(size_t size, int points) {
+    double times[3];
+    size_t base = heap();
+    List *list = List_new(free);
+
+    double start = now();
+    for (size_t i = 0; i < size; i++) {
+        if (points) {
+            Point *point = malloc(sizeof(Point));
+            point->x = i;
+            List_add_tail(list, point);
+        } else {
+            int *value = malloc(sizeof(int));
+            *value = i;
+            List_add_tail(list, value);
+        }
+    }
+    times[0] = now() - start;
+    size_t bytes = heap() - base;
+
+    start = now();
+    double sum = 0;
+    for (Node *node = list->head; node; node = node->next) {
+        sum += points ? ((Point *) node->data)->x : *(int *) node->data;
+    }
+    sink = sum;
+    times[1] = now() - start;
+
+    start = now();
+    List_clear(list);
+    times[2] = now() - start;
+
+    List_free(list);
+    report(points ? "List of Point" : "List of int", size, bytes, times);
+}
+
+static void bench_ints(size_t size) {
+    double times[3];
+    size_t base = heap();
+    IntList *list = IntList_new();
+
+    double start = now();
+    for (size_t i = 0; i < size; i++) {
+        IntList_add_tail(list, i);
+    }
+    times[0] = now() - start;
+    size_t bytes = heap() - base;
+
+    start = now();
+    double sum = 0;
+    for (IntListNode *node = list->head; node; node = node->next) {
+        sum += node->data;
+    }
+    sink = sum;
+    times[1] = now() - start;
+
+    start = now();
+    IntList_clear(list);
+    times[2] = now() - start;
+
+    IntList_free(list);
+    report("IntList", size, bytes, times);
+}
+
+static void bench_points(size_t size) {
+    double times[3];
+    size_t base = heap();
+    PointList *list = PointList_new();
+
+    double start = now();
+    for (size_t i = 0; i < size; i++) {
+        Point point = { i, 0, 0 };
+        PointList_add_tail(list, point);
+    }
+    times[0] = now() - start;
+    size_t bytes = heap() - base;
+
+    start = now();
+    double sum = 0;
+    for (PointListNode *node = list->head; node; node = node->next) {
+        sum += node->data.x;
+    }
+    sink = sum;
+    times[1] = now() - start;
+
+    start = now();
+    PointList_clear(list);
+    times[2] = now() - start;
+
+    PointList_free(list);
+    report("PointList", size, bytes, times);
+}
+
+/*
+ * Typed Lists against List holding pointers to separately
+ * allocated ints and Points
+ */
+int main(int argc, char *argv[]) {
+    size_t max = argc > 1 ? strtoul(argv[1], NULL, 10) : 1000000;
+
+    for (size_t size = 1000; size <= max; size *= 10) {
+        bench_ints(size);
+        bench_list(size, 0);
+        bench_points(size);
+        bench_list(size, 1);
+    }
+    return 0;
+}
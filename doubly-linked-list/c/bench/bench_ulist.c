@@ -0,0 +1,69 @@
+#define _POSIX_C_SOURCE 199309L
+
+#include <stdio.h>
+#include <time.h>
+
+#include "../src/list.h"
+#include "../src/ulist.h"
+
+#define SIZE   2000000
+#define ROUNDS 10
+
+static double now(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+/*
+ * Build both lists with interleaved inserts so List nodes
+ * are not laid out in order, then time full scans and
+ * middle index lookups
+ */
+int main(void) {
+    List *list = List_new(NULL);
+    UList *ulist = UList_new(NULL);
+
+    for (int i = 0; i < SIZE; i++) {
+        if (i % 2) {
+            List_add_head(list, NULL);
+            UList_add_head(ulist, NULL);
+        } else {
+            List_add_tail(list, NULL);
+            UList_add_tail(ulist, NULL);
+        }
+    }
+
+    double start = now();
+    for (int r = 0; r < ROUNDS; r++) {
+        List_get_index(list, NULL);
+    }
+    double list_scan = (now() - start) / ((double) SIZE * ROUNDS);
+
+    start = now();
+    for (int r = 0; r < ROUNDS; r++) {
+        UList_get_index(ulist, &start);
+    }
+    double ulist_scan = (now() - start) / ((double) SIZE * ROUNDS);
+
+    start = now();
+    for (int r = 0; r < ROUNDS; r++) {
+        List_get_at(list, SIZE / 2);
+    }
+    double list_at = (now() - start) / ROUNDS;
+
+    start = now();
+    for (int r = 0; r < ROUNDS; r++) {
+        UList_get_at(ulist, SIZE / 2);
+    }
+    double ulist_at = (now() - start) / ROUNDS;
+
+    printf("scan   list: %.2f ns/element, ulist: %.2f ns/element (%.1fx)\n",
+           list_scan, ulist_scan, list_scan / ulist_scan);
+    printf("get_at list: %.0f ns, ulist: %.0f ns (%.1fx)\n",
+           list_at, ulist_at, list_at / ulist_at);
+
+    List_free(list);
+    UList_free(ulist);
+    return 0;
+}
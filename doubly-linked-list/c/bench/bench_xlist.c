@@ -0,0 +1,114 @@
+#define _GNU_SOURCE
+
+#include <malloc.h>
+#include <stdio.h>
+#include <time.h>
+
+#include "../src/list.h"
+#include "../src/xlist.h"
+
+static volatile size_t sink;
+
+static double now(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+static size_t heap(void) {
+    struct mallinfo2 info = mallinfo2();
+    return info.uordblks + info.hblkhd;
+}
+
+static void report(const char *name, size_t size, size_t bytes, double times[4]) {
+    printf("%s %zu: %.1f bytes/element, add_tail %.1f ns, walk %.1f ns, "
+           "reverse %.1f ns, delete %.1f ns\n",
+           name, size, (double) bytes / size,
+           times[0] / size, times[1] / size, times[2], times[3] / size);
+}
+
+static void bench_list(size_t size, int pooled) {
+    double times[4];
+    size_t base = heap();
+    List *list = List_new(NULL);
+    if (pooled) {
+        Pool *pool = Pool_new(sizeof(Node), 4096);
+        List_free(list);
+        list = List_new_pooled(NULL, pool);
+        Pool_free(pool);
+    }
+
+    double start = now();
+    for (size_t i = 0; i < size; i++) {
+        List_add_tail(list, (void *) i);
+    }
+    times[0] = now() - start;
+    size_t bytes = heap() - base;
+
+    start = now();
+    for (Node *node = list->head; node; node = node->next) {
+        sink += (size_t) node->data;
+    }
+    times[1] = now() - start;
+
+    start = now();
+    List_reverse(list);
+    times[2] = now() - start;
+
+    start = now();
+    while (list->head) {
+        List_delete(list, list->head);
+    }
+    times[3] = now() - start;
+
+    List_free(list);
+    report(pooled ? "pooled List" : "List", size, bytes, times);
+}
+
+static void bench_xlist(size_t size) {
+    double times[4];
+    size_t base = heap();
+    XList *list = XList_new(NULL);
+
+    double start = now();
+    for (size_t i = 0; i < size; i++) {
+        XList_add_tail(list, (void *) i);
+    }
+    times[0] = now() - start;
+    size_t bytes = heap() - base;
+
+    start = now();
+    for (XCursor cursor = XList_first(list); cursor.node; XList_next(&cursor)) {
+        sink += (size_t) cursor.node->data;
+    }
+    times[1] = now() - start;
+
+    start = now();
+    XList_reverse(list);
+    times[2] = now() - start;
+
+    start = now();
+    XCursor cursor = XList_first(list);
+    while (cursor.node) {
+        XList_delete(list, &cursor);
+    }
+    times[3] = now() - start;
+
+    XList_free(list);
+    report("XList", size, bytes, times);
+}
+
+/*
+ * Heap bytes per element and per operation times of a List, a
+ * pooled List and an XList, reverse timed once for the whole List
+ */
+int main(int argc, char *argv[]) {
+    size_t max = argc > 1 ? strtoul(argv[1], NULL, 10) : 10000000;
+
+    for (size_t size = 1000; size <= max; size *= 10) {
+        bench_list(size, 0);
+        bench_list(size, 1);
+        bench_xlist(size);
+    }
+    return 0;
+}
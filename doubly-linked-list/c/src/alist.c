@@ -0,0 +1,250 @@
+#include <string.h>
+
+#include "alloc.h"
+#include "alist.h"
+
+#define ALIST_MAX UINT32_MAX
+
+/*
+ * Internal helper functions
+ */
+static AHandle AList_handle(AList *list, uint32_t index);
+static uint32_t AList_index(AList *list, AHandle handle);
+static void AList_grow(AList *list, size_t capacity);
+static AHandle AList_link(AList *list, uint32_t prev, void *data);
+static void AList_unlink(AList *list, uint32_t index);
+
+/*
+ * Creates a new AList, holding only its sentinel
+ */
+AList *AList_new(Free free) {
+    AList *list = LIST_CALLOC(1, sizeof(AList));
+    list->free = free;
+    list->top = 1;
+    AList_grow(list, 16);
+    return list;
+}
+
+/*
+ * Copy AList with a single memcpy of its Nodes, handles stay valid
+ * in the copy, which shares data without owning it
+ */
+AList *AList_copy(AList *list) {
+    AList *copy = LIST_MALLOC(sizeof(AList));
+    *copy = *list;
+    copy->free = NULL;
+    copy->nodes = LIST_MALLOC(list->capacity * sizeof(ANode));
+    memcpy(copy->nodes, list->nodes, list->top * sizeof(ANode));
+    return copy;
+}
+
+/*
+ * Free AList allocated memory
+ */
+void AList_free(AList *list) {
+    AList_clear(list);
+    LIST_FREE(list->nodes);
+    LIST_FREE(list);
+}
+
+/*
+ * Move Nodes to an array of capacity slots, links being
+ * indexes nothing needs fixing up
+ */
+static void AList_grow(AList *list, size_t capacity) {
+    if (capacity > ALIST_MAX) {
+        capacity = ALIST_MAX;
+    }
+    ANode *nodes = LIST_CALLOC(capacity, sizeof(ANode));
+    if (list->nodes) {
+        memcpy(nodes, list->nodes, list->top * sizeof(ANode));
+        LIST_FREE(list->nodes);
+    }
+    list->nodes = nodes;
+    list->capacity = capacity;
+}
+
+/*
+ * Make room for size elements without growing again
+ */
+void AList_reserve(AList *list, size_t size) {
+    if (size + 1 > list->capacity) {
+        AList_grow(list, size + 1);
+    }
+}
+
+/*
+ * Handle of a live Node
+ */
+static AHandle AList_handle(AList *list, uint32_t index) {
+    return index ? (AHandle) list->nodes[index].generation << 32 | index : 0;
+}
+
+/*
+ * Index of the Node a handle refers to, zero when stale
+ */
+static uint32_t AList_index(AList *list, AHandle handle) {
+    uint32_t index = handle & ALIST_MAX;
+    uint32_t generation = handle >> 32;
+    if (!index || index >= list->top || list->nodes[index].generation != generation) {
+        return 0;
+    }
+    return index;
+}
+
+/*
+ * Handle refers to a Node still in AList ?
+ */
+int AList_is_valid(AList *list, AHandle handle) {
+    return AList_index(list, handle) ? 1 : 0;
+}
+
+/*
+ * Get Node data, NULL when the handle is stale
+ */
+void *AList_get(AList *list, AHandle handle) {
+    uint32_t index = AList_index(list, handle);
+    return index ? list->nodes[index].data : NULL;
+}
+
+/*
+ * Get head handle, zero when empty
+ */
+AHandle AList_first(AList *list) {
+    return AList_handle(list, list->nodes[0].next);
+}
+
+/*
+ * Get tail handle, zero when empty
+ */
+AHandle AList_last(AList *list) {
+    return AList_handle(list, list->nodes[0].prev);
+}
+
+/*
+ * Get next handle, zero at the tail or when the handle is stale
+ */
+AHandle AList_next(AList *list, AHandle handle) {
+    uint32_t index = AList_index(list, handle);
+    return index ? AList_handle(list, list->nodes[index].next) : 0;
+}
+
+/*
+ * Get previous handle, zero at the head or when the handle is stale
+ */
+AHandle AList_prev(AList *list, AHandle handle) {
+    uint32_t index = AList_index(list, handle);
+    return index ? AList_handle(list, list->nodes[index].prev) : 0;
+}
+
+/*
+ * Link a Node after prev, reusing a vacant slot when there is one,
+ * zero when every index is taken. Generations are odd while a Node
+ * is live
+ */
+static AHandle AList_link(AList *list, uint32_t prev, void *data) {
+    uint32_t index = list->vacant;
+    if (index) {
+        list->vacant = list->nodes[index].next;
+    } else if (list->top == ALIST_MAX) {
+        return 0;
+    } else {
+        if (list->top == list->capacity) {
+            AList_grow(list, (size_t) list->capacity * 2);
+        }
+        index = list->top++;
+    }
+
+    ANode *nodes = list->nodes;
+    uint32_t next = nodes[prev].next;
+    nodes[index].data = data;
+    nodes[index].prev = prev;
+    nodes[index].next = next;
+    nodes[index].generation++;
+    nodes[prev].next = index;
+    nodes[next].prev = index;
+    list->size++;
+    return AList_handle(list, index);
+}
+
+/*
+ * Unlink a Node and make its slot vacant, staling its handles
+ */
+static void AList_unlink(AList *list, uint32_t index) {
+    ANode *nodes = list->nodes;
+    nodes[nodes[index].prev].next = nodes[index].next;
+    nodes[nodes[index].next].prev = nodes[index].prev;
+    nodes[index].data = NULL;
+    nodes[index].generation++;
+    nodes[index].next = list->vacant;
+    list->vacant = index;
+    list->size--;
+}
+
+/*
+ * Add data at the head
+ */
+AHandle AList_add_head(AList *list, void *data) {
+    return AList_link(list, 0, data);
+}
+
+/*
+ * Add data at the tail
+ */
+AHandle AList_add_tail(AList *list, void *data) {
+    return AList_link(list, list->nodes[0].prev, data);
+}
+
+/*
+ * Add data before ref, zero when ref is stale
+ */
+AHandle AList_add_before(AList *list, AHandle ref, void *data) {
+    uint32_t index = AList_index(list, ref);
+    return index ? AList_link(list, list->nodes[index].prev, data) : 0;
+}
+
+/*
+ * Add data after ref, zero when ref is stale
+ */
+AHandle AList_add_after(AList *list, AHandle ref, void *data) {
+    uint32_t index = AList_index(list, ref);
+    return index ? AList_link(list, index, data) : 0;
+}
+
+/*
+ * Clear AList, staling every handle. Slots stay allocated
+ */
+void AList_clear(AList *list) {
+    ANode *nodes = list->nodes;
+    for (uint32_t index = nodes[0].next; index; index = nodes[index].next) {
+        if (list->free) {
+            list->free(nodes[index].data);
+        }
+        nodes[index].data = NULL;
+        nodes[index].generation++;
+    }
+
+    list->vacant = 0;
+    for (uint32_t index = list->top - 1; index; index--) {
+        nodes[index].next = list->vacant;
+        list->vacant = index;
+    }
+    nodes[0].next = 0;
+    nodes[0].prev = 0;
+    list->size = 0;
+}
+
+/*
+ * Delete Node, returning 0 when the handle is stale
+ */
+int AList_delete(AList *list, AHandle handle) {
+    uint32_t index = AList_index(list, handle);
+    if (!index) {
+        return 0;
+    }
+    if (list->free) {
+        list->free(list->nodes[index].data);
+    }
+    AList_unlink(list, index);
+    return 1;
+}
@@ -0,0 +1,61 @@
+#ifndef ALIST_H
+#define ALIST_H
+
+#include <stdint.h>
+#include <stdlib.h>
+
+#include "list.h"
+
+/*
+ * List whose Nodes live in one growable array, linked by 32 bit
+ * indexes. Slot 0 is a sentinel whose next is the head and prev the
+ * tail. Holding no pointers, the array may be moved or copied with
+ * memcpy
+ */
+typedef struct ANode ANode;
+typedef struct AList AList;
+
+/*
+ * Generation in the high half, index in the low half,
+ * zero is never a valid handle
+ */
+typedef uint64_t AHandle;
+
+struct ANode {
+    void *data;
+    uint32_t next;
+    uint32_t prev;
+    uint32_t generation;
+};
+
+struct AList {
+    ANode *nodes;
+    uint32_t capacity;
+    uint32_t top;
+    uint32_t vacant;
+    size_t size;
+    Free free;
+};
+
+AList *AList_new(Free free);
+AList *AList_copy(AList *list);
+void AList_free(AList *list);
+void AList_reserve(AList *list, size_t size);
+
+int AList_is_valid(AList *list, AHandle handle);
+void *AList_get(AList *list, AHandle handle);
+
+AHandle AList_first(AList *list);
+AHandle AList_last(AList *list);
+AHandle AList_next(AList *list, AHandle handle);
+AHandle AList_prev(AList *list, AHandle handle);
+
+AHandle AList_add_head(AList *list, void *data);
+AHandle AList_add_tail(AList *list, void *data);
+AHandle AList_add_before(AList *list, AHandle ref, void *data);
+AHandle AList_add_after(AList *list, AHandle ref, void *data);
+
+void AList_clear(AList *list);
+int AList_delete(AList *list, AHandle handle);
+
+#endif
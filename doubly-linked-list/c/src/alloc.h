@@ -0,0 +1,21 @@
+#ifndef ALLOC_H
+#define ALLOC_H
+
+#include <stdlib.h>
+
+/*
+ * Allocator used by the List modules. Builds may route it through
+ * their own functions, e.g. -DLIST_MALLOC=my_malloc with matching
+ * LIST_CALLOC and LIST_FREE, to count or trace allocations
+ */
+#ifdef LIST_MALLOC
+void *LIST_MALLOC(size_t size);
+void *LIST_CALLOC(size_t count, size_t size);
+void LIST_FREE(void *ptr);
+#else
+#define LIST_MALLOC malloc
+#define LIST_CALLOC calloc
+#define LIST_FREE free
+#endif
+
+#endif
@@ -0,0 +1,212 @@
+#include <string.h>
+
+#include "alloc.h"
+#include "cache.h"
+
+/*
+ * Magazines a thread holds for one Cache
+ */
+typedef struct {
+    Cache *cache;
+    Magazine *loaded;
+    Magazine *previous;
+} CacheThread;
+
+static _Thread_local CacheThread Cache_threads[CACHE_THREAD_SLOTS];
+static pthread_key_t Cache_key;
+static pthread_once_t Cache_once = PTHREAD_ONCE_INIT;
+
+/*
+ * Internal helper functions
+ */
+static void Cache_key_new(void);
+static void Cache_exit(void *arg);
+static CacheThread *Cache_thread(Cache *cache);
+static Magazine *Cache_magazine_new(void);
+static void Cache_put(CacheThread *thread);
+
+/*
+ * Create the key whose destructor flushes a thread's
+ * magazines when it exits
+ */
+static void Cache_key_new(void) {
+    pthread_key_create(&Cache_key, Cache_exit);
+}
+
+/*
+ * Flush every Cache the exiting thread used
+ */
+static void Cache_exit(void *arg) {
+    (void) arg;
+    for (int i = 0; i < CACHE_THREAD_SLOTS; i++) {
+        if (Cache_threads[i].cache) {
+            Cache_flush(Cache_threads[i].cache);
+        }
+    }
+}
+
+/*
+ * Creates a new empty Magazine
+ */
+static Magazine *Cache_magazine_new(void) {
+    Magazine *magazine = LIST_MALLOC(sizeof(Magazine));
+    magazine->next = NULL;
+    magazine->count = 0;
+    return magazine;
+}
+
+/*
+ * Get this thread's magazines for Cache, setting them up on first
+ * use, or NULL when the thread already serves too many Caches
+ */
+static CacheThread *Cache_thread(Cache *cache) {
+    CacheThread *free_slot = NULL;
+    for (int i = 0; i < CACHE_THREAD_SLOTS; i++) {
+        if (Cache_threads[i].cache == cache) {
+            return &Cache_threads[i];
+        }
+        if (!free_slot && !Cache_threads[i].cache) {
+            free_slot = &Cache_threads[i];
+        }
+    }
+    if (!free_slot) {
+        return NULL;
+    }
+
+    pthread_once(&Cache_once, Cache_key_new);
+    pthread_setspecific(Cache_key, Cache_threads);
+    free_slot->cache = cache;
+    free_slot->loaded = Cache_magazine_new();
+    free_slot->previous = Cache_magazine_new();
+    return free_slot;
+}
+
+/*
+ * Allocate a zeroed object, from this thread's magazines when
+ * they have one, else trading an empty magazine for a full one
+ */
+void *Cache_alloc(Cache *cache) {
+    CacheThread *thread = Cache_thread(cache);
+    if (!thread) {
+        return LIST_CALLOC(1, cache->size);
+    }
+
+    if (!thread->loaded->count && thread->previous->count) {
+        Magazine *magazine = thread->loaded;
+        thread->loaded = thread->previous;
+        thread->previous = magazine;
+
+    } else if (!thread->loaded->count) {
+        pthread_mutex_lock(&cache->lock);
+        Magazine *full = cache->full;
+        if (full) {
+            cache->full = full->next;
+            thread->previous->next = cache->empty;
+            cache->empty = thread->previous;
+            thread->previous = thread->loaded;
+            thread->loaded = full;
+        }
+        pthread_mutex_unlock(&cache->lock);
+        if (!full) {
+            return LIST_CALLOC(1, cache->size);
+        }
+    }
+
+    void *object = thread->loaded->items[--thread->loaded->count];
+    memset(object, 0, cache->size);
+    return object;
+}
+
+/*
+ * Hand this thread's full previous magazine to the depot,
+ * taking an empty one back
+ */
+static void Cache_put(CacheThread *thread) {
+    Cache *cache = thread->cache;
+    pthread_mutex_lock(&cache->lock);
+    Magazine *empty = cache->empty;
+    if (empty) {
+        cache->empty = empty->next;
+    }
+    thread->previous->next = cache->full;
+    cache->full = thread->previous;
+    pthread_mutex_unlock(&cache->lock);
+
+    thread->previous = thread->loaded;
+    thread->loaded = empty ? empty : Cache_magazine_new();
+}
+
+/*
+ * Release an object allocated from Cache on any thread
+ */
+void Cache_release(Cache *cache, void *object) {
+    CacheThread *thread = Cache_thread(cache);
+    if (!thread) {
+        LIST_FREE(object);
+        return;
+    }
+
+    if (thread->loaded->count == CACHE_MAGAZINE && !thread->previous->count) {
+        Magazine *magazine = thread->loaded;
+        thread->loaded = thread->previous;
+        thread->previous = magazine;
+
+    } else if (thread->loaded->count == CACHE_MAGAZINE) {
+        Cache_put(thread);
+    }
+
+    thread->loaded->items[thread->loaded->count++] = object;
+}
+
+/*
+ * Return this thread's magazines to the depot, so another
+ * thread can reuse their objects
+ */
+void Cache_flush(Cache *cache) {
+    for (int i = 0; i < CACHE_THREAD_SLOTS; i++) {
+        CacheThread *thread = &Cache_threads[i];
+        if (thread->cache != cache) {
+            continue;
+        }
+
+        Magazine *magazines[] = { thread->loaded, thread->previous };
+        pthread_mutex_lock(&cache->lock);
+        for (int m = 0; m < 2; m++) {
+            Magazine **list = magazines[m]->count ? &cache->full : &cache->empty;
+            magazines[m]->next = *list;
+            *list = magazines[m];
+        }
+        pthread_mutex_unlock(&cache->lock);
+
+        thread->cache = NULL;
+        thread->loaded = NULL;
+        thread->previous = NULL;
+    }
+}
+
+/*
+ * Free the objects and magazines held by the depot,
+ * returning how many objects were freed
+ */
+size_t Cache_trim(Cache *cache) {
+    pthread_mutex_lock(&cache->lock);
+    Magazine *lists[] = { cache->full, cache->empty };
+    cache->full = NULL;
+    cache->empty = NULL;
+    pthread_mutex_unlock(&cache->lock);
+
+    size_t count = 0;
+    for (int l = 0; l < 2; l++) {
+        Magazine *magazine = lists[l];
+        while (magazine) {
+            Magazine *next = magazine->next;
+            for (size_t i = 0; i < magazine->count; i++) {
+                LIST_FREE(magazine->items[i]);
+            }
+            count += magazine->count;
+            LIST_FREE(magazine);
+            magazine = next;
+        }
+    }
+    return count;
+}
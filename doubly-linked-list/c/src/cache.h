@@ -0,0 +1,40 @@
+#ifndef CACHE_H
+#define CACHE_H
+
+#include <pthread.h>
+#include <stdlib.h>
+
+/*
+ * Object cache with per thread magazines (Bonwick, Adams): each
+ * thread allocates from and releases to two private magazines of
+ * free objects, and only trades whole magazines with the shared
+ * depot, so the depot lock is taken once per CACHE_MAGAZINE
+ * operations. Objects may be released on any thread
+ */
+#define CACHE_MAGAZINE 64
+#define CACHE_THREAD_SLOTS 4
+
+typedef struct Magazine Magazine;
+typedef struct Cache Cache;
+
+struct Magazine {
+    Magazine *next;
+    size_t count;
+    void *items[CACHE_MAGAZINE];
+};
+
+struct Cache {
+    pthread_mutex_t lock;
+    Magazine *full;
+    Magazine *empty;
+    size_t size;
+};
+
+#define CACHE_INITIALIZER(size) { PTHREAD_MUTEX_INITIALIZER, NULL, NULL, size }
+
+void *Cache_alloc(Cache *cache);
+void Cache_release(Cache *cache, void *object);
+void Cache_flush(Cache *cache);
+size_t Cache_trim(Cache *cache);
+
+#endif
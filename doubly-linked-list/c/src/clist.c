@@ -0,0 +1,356 @@
+#include "alloc.h"
+#include "clist.h"
+
+#define CLIST_LOCKS 6
+
+/*
+ * Internal helper functions
+ */
+static CNode *CList_node_new(CList *list, void *data);
+static void CList_node_free(void *node);
+static int CList_lock(CNode *nodes[], int count);
+static void CList_unlock(CNode *nodes[], int count);
+static void CList_link(CNode *prev, CNode *node, CNode *next);
+static void CList_count(CThread *thread, long delta);
+
+/*
+ * Creates a new CList, between a head and a tail sentinel
+ */
+CList *CList_new(Free free) {
+    CList *list = LIST_CALLOC(1, sizeof(CList));
+    list->head = CList_node_new(list, NULL);
+    list->tail = CList_node_new(list, NULL);
+    atomic_store(&list->head->next, list->tail);
+    atomic_store(&list->tail->prev, list->head);
+    list->epoch = Epoch_new();
+    atomic_init(&list->threads, NULL);
+    list->free = free;
+    return list;
+}
+
+/*
+ * Free CList allocated memory, no thread may still be using it
+ */
+void CList_free(CList *list) {
+    CNode *node = list->head;
+    while (node) {
+        CNode *next = atomic_load(&node->next);
+        if (node != list->head && node != list->tail && list->free) {
+            list->free(node->data);
+        }
+        pthread_mutex_destroy(&node->lock);
+        LIST_FREE(node);
+        node = next;
+    }
+    CThread *thread = atomic_load(&list->threads);
+    while (thread) {
+        CThread *next = thread->next;
+        LIST_FREE(thread);
+        thread = next;
+    }
+    Epoch_free(list->epoch);
+    LIST_FREE(list);
+}
+
+/*
+ * Get a per thread handle for CList edits. A reused Epoch handle
+ * brings back the CThread wrapping it, count included, so the
+ * counts of finished threads still add up
+ */
+CThread *CList_register(CList *list) {
+    EpochThread *handle = Epoch_register(list->epoch);
+    for (CThread *thread = atomic_load(&list->threads); thread; thread = thread->next) {
+        if (thread->handle == handle) {
+            return thread;
+        }
+    }
+
+    CThread *thread = LIST_CALLOC(1, sizeof(CThread));
+    thread->handle = handle;
+    atomic_init(&thread->count, 0);
+    thread->next = atomic_load(&list->threads);
+    while (!atomic_compare_exchange_weak(&list->threads, &thread->next, thread));
+    return thread;
+}
+
+/*
+ * Give up a per thread handle
+ */
+void CList_unregister(CThread *thread) {
+    Epoch_unregister(thread->handle);
+}
+
+/*
+ * Creates a new CNode
+ */
+static CNode *CList_node_new(CList *list, void *data) {
+    CNode *node = LIST_CALLOC(1, sizeof(CNode));
+    node->data = data;
+    node->list = list;
+    atomic_init(&node->next, NULL);
+    atomic_init(&node->prev, NULL);
+    atomic_init(&node->deleted, 0);
+    pthread_mutex_init(&node->lock, NULL);
+    return node;
+}
+
+/*
+ * Free a retired CNode and its element
+ */
+static void CList_node_free(void *ptr) {
+    CNode *node = ptr;
+    if (node->list->free) {
+        node->list->free(node->data);
+    }
+    pthread_mutex_destroy(&node->lock);
+    LIST_FREE(node);
+}
+
+/*
+ * Lock distinct CNodes in address order, so no two edits can wait
+ * on each other whatever the List order, and return how many
+ */
+static int CList_lock(CNode *nodes[], int count) {
+    int distinct = 0;
+    for (int i = 0; i < count; i++) {
+        int j = distinct;
+        while (j > 0 && nodes[j - 1] > nodes[i]) {
+            j--;
+        }
+        if (j > 0 && nodes[j - 1] == nodes[i]) {
+            continue;
+        }
+        CNode *node = nodes[i];
+        for (int k = distinct; k > j; k--) {
+            nodes[k] = nodes[k - 1];
+        }
+        nodes[j] = node;
+        distinct++;
+    }
+    for (int i = 0; i < distinct; i++) {
+        pthread_mutex_lock(&nodes[i]->lock);
+    }
+    return distinct;
+}
+
+/*
+ * Unlock CNodes taken by CList_lock
+ */
+static void CList_unlock(CNode *nodes[], int count) {
+    for (int i = count - 1; i >= 0; i--) {
+        pthread_mutex_unlock(&nodes[i]->lock);
+    }
+}
+
+/*
+ * Link node between prev and next, all three locked
+ */
+static void CList_link(CNode *prev, CNode *node, CNode *next) {
+    atomic_store(&node->prev, prev);
+    atomic_store(&node->next, next);
+    atomic_store(&prev->next, node);
+    atomic_store(&next->prev, node);
+}
+
+/*
+ * Add delta to this thread's count, which only it writes
+ */
+static void CList_count(CThread *thread, long delta) {
+    long count = atomic_load_explicit(&thread->count, memory_order_relaxed);
+    atomic_store_explicit(&thread->count, count + delta, memory_order_relaxed);
+}
+
+/*
+ * Number of elements, summing every thread's count. Exact once
+ * edits are done, approximate while they run
+ */
+size_t CList_size(CList *list) {
+    long size = 0;
+    for (CThread *thread = atomic_load(&list->threads); thread; thread = thread->next) {
+        size += atomic_load_explicit(&thread->count, memory_order_relaxed);
+    }
+    return size > 0 ? (size_t) size : 0;
+}
+
+/*
+ * Get first CNode, NULL when empty. Callers iterating
+ * alongside writers stay inside a critical section
+ */
+CNode *CList_first(CList *list) {
+    return CList_next(list, list->head);
+}
+
+/*
+ * Get the CNode after node, NULL at the end
+ */
+CNode *CList_next(CList *list, CNode *node) {
+    CNode *next = atomic_load(&node->next);
+    return next == list->tail ? NULL : next;
+}
+
+/*
+ * Add element to CList head
+ */
+CNode *CList_add_head(CList *list, CThread *thread, void *data) {
+    return CList_add_after(list, thread, list->head, data);
+}
+
+/*
+ * Add element to CList tail
+ */
+CNode *CList_add_tail(CList *list, CThread *thread, void *data) {
+    return CList_add_before(list, thread, list->tail, data);
+}
+
+/*
+ * Add element before ref, NULL if ref was deleted
+ */
+CNode *CList_add_before(CList *list, CThread *thread, CNode *ref, void *data) {
+    CNode *locks[2];
+    CNode *prev;
+    int count;
+
+    Epoch_enter(thread->handle);
+    for (;;) {
+        if (atomic_load(&ref->deleted)) {
+            Epoch_exit(thread->handle);
+            return NULL;
+        }
+        prev = atomic_load(&ref->prev);
+        locks[0] = prev;
+        locks[1] = ref;
+        count = CList_lock(locks, 2);
+        if (!atomic_load(&ref->deleted) && atomic_load(&ref->prev) == prev) {
+            break;
+        }
+        CList_unlock(locks, count);
+    }
+
+    CNode *node = CList_node_new(list, data);
+    CList_link(prev, node, ref);
+    CList_count(thread, 1);
+    CList_unlock(locks, count);
+    Epoch_exit(thread->handle);
+    return node;
+}
+
+/*
+ * Add element after ref, NULL if ref was deleted
+ */
+CNode *CList_add_after(CList *list, CThread *thread, CNode *ref, void *data) {
+    CNode *locks[2];
+    CNode *next;
+    int count;
+
+    Epoch_enter(thread->handle);
+    for (;;) {
+        if (atomic_load(&ref->deleted)) {
+            Epoch_exit(thread->handle);
+            return NULL;
+        }
+        next = atomic_load(&ref->next);
+        locks[0] = ref;
+        locks[1] = next;
+        count = CList_lock(locks, 2);
+        if (!atomic_load(&ref->deleted) && atomic_load(&ref->next) == next) {
+            break;
+        }
+        CList_unlock(locks, count);
+    }
+
+    CNode *node = CList_node_new(list, data);
+    CList_link(ref, node, next);
+    CList_count(thread, 1);
+    CList_unlock(locks, count);
+    Epoch_exit(thread->handle);
+    return node;
+}
+
+/*
+ * Swap CNodes, 0 if either was deleted. Adjacent CNodes lock
+ * three or four distinct CNodes instead of six
+ */
+int CList_swap(CList *list, CThread *thread, CNode *a, CNode *b) {
+    (void) list;
+    if (a == b) {
+        return 1;
+    }
+
+    CNode *locks[CLIST_LOCKS];
+    CNode *a_prev, *a_next, *b_prev, *b_next;
+    int count;
+
+    Epoch_enter(thread->handle);
+    for (;;) {
+        if (atomic_load(&a->deleted) || atomic_load(&b->deleted)) {
+            Epoch_exit(thread->handle);
+            return 0;
+        }
+        a_prev = locks[0] = atomic_load(&a->prev);
+        a_next = locks[1] = atomic_load(&a->next);
+        b_prev = locks[2] = atomic_load(&b->prev);
+        b_next = locks[3] = atomic_load(&b->next);
+        locks[4] = a;
+        locks[5] = b;
+        count = CList_lock(locks, CLIST_LOCKS);
+        if (!atomic_load(&a->deleted) && !atomic_load(&b->deleted) &&
+            atomic_load(&a->prev) == a_prev && atomic_load(&a->next) == a_next &&
+            atomic_load(&b->prev) == b_prev && atomic_load(&b->next) == b_next) {
+            break;
+        }
+        CList_unlock(locks, count);
+    }
+
+    if (a_next == b) {
+        CList_link(a_prev, b, a);
+        CList_link(b, a, b_next);
+    } else if (b_next == a) {
+        CList_link(b_prev, a, b);
+        CList_link(a, b, a_next);
+    } else {
+        CList_link(a_prev, b, a_next);
+        CList_link(b_prev, a, b_next);
+    }
+
+    CList_unlock(locks, count);
+    Epoch_exit(thread->handle);
+    return 1;
+}
+
+/*
+ * Delete CNode from CList, 0 if it was already deleted.
+ * Its memory and element are freed once no thread can see it
+ */
+int CList_delete(CList *list, CThread *thread, CNode *node) {
+    (void) list;
+    CNode *locks[3];
+    CNode *prev, *next;
+    int count;
+
+    Epoch_enter(thread->handle);
+    for (;;) {
+        if (atomic_load(&node->deleted)) {
+            Epoch_exit(thread->handle);
+            return 0;
+        }
+        prev = locks[0] = atomic_load(&node->prev);
+        next = locks[1] = atomic_load(&node->next);
+        locks[2] = node;
+        count = CList_lock(locks, 3);
+        if (!atomic_load(&node->deleted) &&
+            atomic_load(&node->prev) == prev && atomic_load(&node->next) == next) {
+            break;
+        }
+        CList_unlock(locks, count);
+    }
+
+    atomic_store(&prev->next, next);
+    atomic_store(&next->prev, prev);
+    atomic_store(&node->deleted, 1);
+    CList_count(thread, -1);
+    CList_unlock(locks, count);
+
+    Epoch_retire(thread->handle, node, CList_node_free);
+    Epoch_exit(thread->handle);
+    return 1;
+}
@@ -0,0 +1,71 @@
+#ifndef CLIST_H
+#define CLIST_H
+
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdlib.h>
+
+#include "epoch.h"
+#include "list.h"
+
+/*
+ * Concurrent List with one lock per CNode: an edit locks only
+ * the CNodes whose links it rewrites, so edits far apart proceed
+ * in parallel. Locks are taken in address order after reading the
+ * neighbours optimistically, and the links are validated once held.
+ * Removed CNodes are freed through Epoch, so a thread may hold a
+ * CNode another thread deletes as long as it is inside a critical
+ * section on its CThread handle. Each handle also counts the edits
+ * of its thread, so no edit writes a location shared by all
+ */
+typedef struct CNode CNode;
+typedef struct CList CList;
+typedef struct CThread CThread;
+
+struct CNode {
+    void *data;
+    _Atomic(CNode *) next;
+    _Atomic(CNode *) prev;
+    atomic_int deleted;
+    pthread_mutex_t lock;
+    CList *list;
+};
+
+/*
+ * Per thread handle: the thread's Epoch handle and the count
+ * of elements it added less those it deleted, only it writes
+ */
+struct CThread {
+    EpochThread *handle;
+    atomic_long count;
+    CThread *next;
+    char pad[64];
+};
+
+struct CList {
+    CNode *head;
+    CNode *tail;
+    Epoch *epoch;
+    _Atomic(CThread *) threads;
+    Free free;
+};
+
+CList *CList_new(void (*free)(void *data));
+void CList_free(CList *list);
+
+CThread *CList_register(CList *list);
+void CList_unregister(CThread *thread);
+
+size_t CList_size(CList *list);
+CNode *CList_first(CList *list);
+CNode *CList_next(CList *list, CNode *node);
+
+CNode *CList_add_head(CList *list, CThread *thread, void *data);
+CNode *CList_add_tail(CList *list, CThread *thread, void *data);
+CNode *CList_add_before(CList *list, CThread *thread, CNode *ref, void *data);
+CNode *CList_add_after(CList *list, CThread *thread, CNode *ref, void *data);
+
+int CList_swap(CList *list, CThread *thread, CNode *a, CNode *b);
+int CList_delete(CList *list, CThread *thread, CNode *node);
+
+#endif
@@ -0,0 +1,249 @@
+#include "alloc.h"
+#include "deque.h"
+
+/*
+ * Internal helper functions
+ */
+static DequeAnchor *Deque_anchor_new(DequeNode *head, DequeNode *tail, int status);
+static void Deque_node_free(void *node);
+static void Deque_anchor_free(void *anchor);
+static int Deque_swap(Deque *deque, EpochThread *thread, DequeAnchor *old, DequeAnchor *new);
+static void Deque_stabilize(Deque *deque, EpochThread *thread, DequeAnchor *anchor);
+static int Deque_pop(Deque *deque, EpochThread *thread, void **data, int tail);
+
+/*
+ * Creates a new Deque
+ */
+Deque *Deque_new(Free free) {
+    Deque *deque = LIST_CALLOC(1, sizeof(Deque));
+    atomic_init(&deque->anchor, Deque_anchor_new(NULL, NULL, DEQUE_STABLE));
+    deque->epoch = Epoch_new();
+    deque->free = free;
+    return deque;
+}
+
+/*
+ * Free Deque allocated memory, no thread may still be using it
+ */
+void Deque_free(Deque *deque) {
+    DequeAnchor *anchor = atomic_load(&deque->anchor);
+    if (anchor->status == DEQUE_PUSH_HEAD) {
+        atomic_store(&atomic_load(&anchor->head->next)->prev, anchor->head);
+    } else if (anchor->status == DEQUE_PUSH_TAIL) {
+        atomic_store(&atomic_load(&anchor->tail->prev)->next, anchor->tail);
+    }
+
+    DequeNode *node = anchor->head;
+    while (node) {
+        DequeNode *next = node == anchor->tail ? NULL : atomic_load(&node->next);
+        if (deque->free) {
+            deque->free(node->data);
+        }
+        LIST_FREE(node);
+        node = next;
+    }
+
+    LIST_FREE(anchor);
+    Epoch_free(deque->epoch);
+    LIST_FREE(deque);
+}
+
+/*
+ * Get a per thread handle for Deque operations
+ */
+EpochThread *Deque_register(Deque *deque) {
+    return Epoch_register(deque->epoch);
+}
+
+/*
+ * Give up a per thread handle
+ */
+void Deque_unregister(EpochThread *thread) {
+    Epoch_unregister(thread);
+}
+
+/*
+ * Creates a new DequeAnchor
+ */
+static DequeAnchor *Deque_anchor_new(DequeNode *head, DequeNode *tail, int status) {
+    DequeAnchor *anchor = LIST_MALLOC(sizeof(DequeAnchor));
+    anchor->head = head;
+    anchor->tail = tail;
+    anchor->status = status;
+    return anchor;
+}
+
+static void Deque_node_free(void *node) {
+    LIST_FREE(node);
+}
+
+static void Deque_anchor_free(void *anchor) {
+    LIST_FREE(anchor);
+}
+
+/*
+ * Replace anchor old with new, retiring old on success
+ * and freeing the never published new on failure
+ */
+static int Deque_swap(Deque *deque, EpochThread *thread, DequeAnchor *old, DequeAnchor *new) {
+    if (atomic_compare_exchange_strong(&deque->anchor, &old, new)) {
+        Epoch_retire(thread, old, Deque_anchor_free);
+        return 1;
+    }
+    LIST_FREE(new);
+    return 0;
+}
+
+/*
+ * Finish a push seen in anchor: link the old end to the new
+ * Node, then mark the anchor stable
+ */
+static void Deque_stabilize(Deque *deque, EpochThread *thread, DequeAnchor *anchor) {
+    if (anchor->status == DEQUE_PUSH_TAIL) {
+        DequeNode *prev = atomic_load(&anchor->tail->prev);
+        if (atomic_load(&deque->anchor) != anchor) {
+            return;
+        }
+        DequeNode *next = atomic_load(&prev->next);
+        if (next != anchor->tail) {
+            if (atomic_load(&deque->anchor) != anchor) {
+                return;
+            }
+            if (!atomic_compare_exchange_strong(&prev->next, &next, anchor->tail)) {
+                return;
+            }
+        }
+    } else {
+        DequeNode *next = atomic_load(&anchor->head->next);
+        if (atomic_load(&deque->anchor) != anchor) {
+            return;
+        }
+        DequeNode *prev = atomic_load(&next->prev);
+        if (prev != anchor->head) {
+            if (atomic_load(&deque->anchor) != anchor) {
+                return;
+            }
+            if (!atomic_compare_exchange_strong(&next->prev, &prev, anchor->head)) {
+                return;
+            }
+        }
+    }
+    Deque_swap(deque, thread, anchor, Deque_anchor_new(anchor->head, anchor->tail, DEQUE_STABLE));
+}
+
+/*
+ * Deque is empty ?
+ */
+int Deque_is_empty(Deque *deque, EpochThread *thread) {
+    Epoch_enter(thread);
+    int empty = atomic_load(&deque->anchor)->head == NULL;
+    Epoch_exit(thread);
+    return empty;
+}
+
+/*
+ * Add element to Deque head
+ */
+void Deque_add_head(Deque *deque, EpochThread *thread, void *data) {
+    DequeNode *node = LIST_CALLOC(1, sizeof(DequeNode));
+    node->data = data;
+
+    Epoch_enter(thread);
+    for (;;) {
+        DequeAnchor *anchor = atomic_load(&deque->anchor);
+        if (!anchor->head) {
+            if (Deque_swap(deque, thread, anchor, Deque_anchor_new(node, node, DEQUE_STABLE))) {
+                break;
+            }
+        } else if (anchor->status == DEQUE_STABLE) {
+            atomic_store(&node->next, anchor->head);
+            DequeAnchor *new = Deque_anchor_new(node, anchor->tail, DEQUE_PUSH_HEAD);
+            if (Deque_swap(deque, thread, anchor, new)) {
+                Deque_stabilize(deque, thread, new);
+                break;
+            }
+        } else {
+            Deque_stabilize(deque, thread, anchor);
+        }
+    }
+    Epoch_exit(thread);
+}
+
+/*
+ * Add element to Deque tail
+ */
+void Deque_add_tail(Deque *deque, EpochThread *thread, void *data) {
+    DequeNode *node = LIST_CALLOC(1, sizeof(DequeNode));
+    node->data = data;
+
+    Epoch_enter(thread);
+    for (;;) {
+        DequeAnchor *anchor = atomic_load(&deque->anchor);
+        if (!anchor->tail) {
+            if (Deque_swap(deque, thread, anchor, Deque_anchor_new(node, node, DEQUE_STABLE))) {
+                break;
+            }
+        } else if (anchor->status == DEQUE_STABLE) {
+            atomic_store(&node->prev, anchor->tail);
+            DequeAnchor *new = Deque_anchor_new(anchor->head, node, DEQUE_PUSH_TAIL);
+            if (Deque_swap(deque, thread, anchor, new)) {
+                Deque_stabilize(deque, thread, new);
+                break;
+            }
+        } else {
+            Deque_stabilize(deque, thread, anchor);
+        }
+    }
+    Epoch_exit(thread);
+}
+
+/*
+ * Remove the head or tail Node, handing its element to data
+ */
+static int Deque_pop(Deque *deque, EpochThread *thread, void **data, int tail) {
+    DequeAnchor *anchor;
+    DequeNode *node;
+
+    Epoch_enter(thread);
+    for (;;) {
+        anchor = atomic_load(&deque->anchor);
+        node = tail ? anchor->tail : anchor->head;
+        if (!node) {
+            Epoch_exit(thread);
+            return 0;
+        }
+        if (anchor->head == anchor->tail) {
+            if (Deque_swap(deque, thread, anchor, Deque_anchor_new(NULL, NULL, DEQUE_STABLE))) {
+                break;
+            }
+        } else if (anchor->status == DEQUE_STABLE) {
+            DequeAnchor *new = tail
+                ? Deque_anchor_new(anchor->head, atomic_load(&node->prev), DEQUE_STABLE)
+                : Deque_anchor_new(atomic_load(&node->next), anchor->tail, DEQUE_STABLE);
+            if (Deque_swap(deque, thread, anchor, new)) {
+                break;
+            }
+        } else {
+            Deque_stabilize(deque, thread, anchor);
+        }
+    }
+
+    *data = node->data;
+    Epoch_retire(thread, node, Deque_node_free);
+    Epoch_exit(thread);
+    return 1;
+}
+
+/*
+ * Remove Deque head, 0 if it was empty
+ */
+int Deque_pop_head(Deque *deque, EpochThread *thread, void **data) {
+    return Deque_pop(deque, thread, data, 0);
+}
+
+/*
+ * Remove Deque tail, 0 if it was empty
+ */
+int Deque_pop_tail(Deque *deque, EpochThread *thread, void **data) {
+    return Deque_pop(deque, thread, data, 1);
+}
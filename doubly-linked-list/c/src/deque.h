@@ -0,0 +1,53 @@
+#ifndef DEQUE_H
+#define DEQUE_H
+
+#include <stdatomic.h>
+#include <stdlib.h>
+
+#include "epoch.h"
+#include "list.h"
+
+/*
+ * Lock-free double ended queue for any number of producers and
+ * consumers (Michael, CAS-based lock-free deque). Both ends live
+ * in one immutable DequeAnchor swapped by CAS, and every thread
+ * works through its own EpochThread handle from Deque_register
+ */
+typedef struct DequeNode DequeNode;
+typedef struct DequeAnchor DequeAnchor;
+typedef struct Deque Deque;
+
+enum { DEQUE_STABLE, DEQUE_PUSH_HEAD, DEQUE_PUSH_TAIL };
+
+struct DequeNode {
+    void *data;
+    _Atomic(DequeNode *) next;
+    _Atomic(DequeNode *) prev;
+};
+
+struct DequeAnchor {
+    DequeNode *head;
+    DequeNode *tail;
+    int status;
+};
+
+struct Deque {
+    _Atomic(DequeAnchor *) anchor;
+    Epoch *epoch;
+    Free free;
+};
+
+Deque *Deque_new(void (*free)(void *data));
+void Deque_free(Deque *deque);
+
+EpochThread *Deque_register(Deque *deque);
+void Deque_unregister(EpochThread *thread);
+
+int Deque_is_empty(Deque *deque, EpochThread *thread);
+
+void Deque_add_head(Deque *deque, EpochThread *thread, void *data);
+void Deque_add_tail(Deque *deque, EpochThread *thread, void *data);
+int Deque_pop_head(Deque *deque, EpochThread *thread, void **data);
+int Deque_pop_tail(Deque *deque, EpochThread *thread, void **data);
+
+#endif
@@ -0,0 +1,170 @@
+#include "alloc.h"
+#include "epoch.h"
+
+#define EPOCH_BATCH 64
+
+/*
+ * Internal helper functions
+ */
+static size_t Epoch_advance(Epoch *epoch);
+static void Epoch_reserve(EpochThread *thread);
+static void Epoch_release(Retired *retired, size_t count);
+
+/*
+ * Creates a new Epoch domain
+ */
+Epoch *Epoch_new(void) {
+    Epoch *epoch = LIST_CALLOC(1, sizeof(Epoch));
+    atomic_init(&epoch->global, 0);
+    atomic_init(&epoch->threads, NULL);
+    return epoch;
+}
+
+/*
+ * Free Epoch allocated memory, along with everything still
+ * retired. No thread may be inside a critical section
+ */
+void Epoch_free(Epoch *epoch) {
+    EpochThread *thread = atomic_load(&epoch->threads);
+    while (thread) {
+        EpochThread *next = thread->next;
+        Epoch_release(thread->retired + thread->first, thread->count - thread->first);
+        LIST_FREE(thread->retired);
+        LIST_FREE(thread);
+        thread = next;
+    }
+    LIST_FREE(epoch);
+}
+
+/*
+ * Get a per thread handle, reusing one a finished thread gave up
+ */
+EpochThread *Epoch_register(Epoch *epoch) {
+    for (EpochThread *thread = atomic_load(&epoch->threads); thread; thread = thread->next) {
+        int unused = 0;
+        if (atomic_compare_exchange_strong(&thread->used, &unused, 1)) {
+            return thread;
+        }
+    }
+
+    EpochThread *thread = LIST_CALLOC(1, sizeof(EpochThread));
+    atomic_init(&thread->state, 0);
+    atomic_init(&thread->used, 1);
+    thread->epoch = epoch;
+    thread->next = atomic_load(&epoch->threads);
+    while (!atomic_compare_exchange_weak(&epoch->threads, &thread->next, thread));
+    return thread;
+}
+
+/*
+ * Give up a per thread handle, whatever it still has retired
+ * is freed by the next thread using it or by Epoch_free
+ */
+void Epoch_unregister(EpochThread *thread) {
+    Epoch_collect(thread);
+    atomic_store(&thread->used, 0);
+}
+
+/*
+ * Enter a critical section, pointers read from shared memory
+ * stay valid until the matching Epoch_exit. Sections may nest
+ */
+void Epoch_enter(EpochThread *thread) {
+    if (thread->depth++) {
+        return;
+    }
+    size_t global = atomic_load_explicit(&thread->epoch->global, memory_order_relaxed);
+    atomic_store_explicit(&thread->state, global << 1 | 1, memory_order_relaxed);
+    atomic_thread_fence(memory_order_seq_cst);
+}
+
+/*
+ * Leave a critical section
+ */
+void Epoch_exit(EpochThread *thread) {
+    if (--thread->depth) {
+        return;
+    }
+    atomic_store_explicit(&thread->state, 0, memory_order_release);
+}
+
+/*
+ * Free ptr once no thread can reach it any more, collecting
+ * older memory every EPOCH_BATCH retirements
+ */
+void Epoch_retire(EpochThread *thread, void *ptr, Free destroy) {
+    if (thread->count == thread->capacity) {
+        Epoch_reserve(thread);
+    }
+
+    Retired *retired = &thread->retired[thread->count++];
+    retired->ptr = ptr;
+    retired->free = destroy;
+    retired->epoch = atomic_load(&thread->epoch->global);
+
+    if ((thread->count - thread->first) % EPOCH_BATCH == 0) {
+        Epoch_collect(thread);
+    }
+}
+
+/*
+ * Make room for one more Retired entry, dropping the already
+ * freed ones at the front, or growing when most are pending
+ */
+static void Epoch_reserve(EpochThread *thread) {
+    Retired *retired = thread->retired;
+    if (thread->first <= thread->capacity / 2) {
+        thread->capacity = thread->capacity ? thread->capacity * 2 : EPOCH_BATCH;
+        retired = LIST_MALLOC(thread->capacity * sizeof(Retired));
+    }
+    for (size_t i = thread->first; i < thread->count; i++) {
+        retired[i - thread->first] = thread->retired[i];
+    }
+    if (retired != thread->retired) {
+        LIST_FREE(thread->retired);
+        thread->retired = retired;
+    }
+    thread->count -= thread->first;
+    thread->first = 0;
+}
+
+/*
+ * Move the global epoch forward if every thread inside a critical
+ * section has seen it, returning the current one
+ */
+static size_t Epoch_advance(Epoch *epoch) {
+    size_t global = atomic_load(&epoch->global);
+    for (EpochThread *thread = atomic_load(&epoch->threads); thread; thread = thread->next) {
+        size_t state = atomic_load(&thread->state);
+        if ((state & 1) && state >> 1 != global) {
+            return global;
+        }
+    }
+    if (atomic_compare_exchange_strong(&epoch->global, &global, global + 1)) {
+        return global + 1;
+    }
+    return global;
+}
+
+/*
+ * Free retired memory
+ */
+static void Epoch_release(Retired *retired, size_t count) {
+    for (size_t i = 0; i < count; i++) {
+        retired[i].free(retired[i].ptr);
+    }
+}
+
+/*
+ * Free memory retired two epochs ago or earlier, which no
+ * critical section can still see
+ */
+void Epoch_collect(EpochThread *thread) {
+    size_t global = Epoch_advance(thread->epoch);
+    size_t first = thread->first;
+    while (first < thread->count && thread->retired[first].epoch + 2 <= global) {
+        first++;
+    }
+    Epoch_release(thread->retired + thread->first, first - thread->first);
+    thread->first = first;
+}
@@ -0,0 +1,53 @@
+#ifndef EPOCH_H
+#define EPOCH_H
+
+#include <stdatomic.h>
+#include <stdlib.h>
+
+#include "list.h"
+
+/*
+ * Epoch based reclamation: memory unlinked from a shared structure
+ * is retired, and freed once every thread that could still hold
+ * a pointer to it has left its critical section
+ */
+typedef struct Epoch Epoch;
+typedef struct EpochThread EpochThread;
+typedef struct Retired Retired;
+
+struct Retired {
+    void *ptr;
+    Free free;
+    size_t epoch;
+};
+
+struct EpochThread {
+    atomic_size_t state;
+    atomic_int used;
+    size_t depth;
+    EpochThread *next;
+    Epoch *epoch;
+    Retired *retired;
+    size_t first;
+    size_t count;
+    size_t capacity;
+    char pad[64];
+};
+
+struct Epoch {
+    atomic_size_t global;
+    _Atomic(EpochThread *) threads;
+};
+
+Epoch *Epoch_new(void);
+void Epoch_free(Epoch *epoch);
+
+EpochThread *Epoch_register(Epoch *epoch);
+void Epoch_unregister(EpochThread *thread);
+
+void Epoch_enter(EpochThread *thread);
+void Epoch_exit(EpochThread *thread);
+void Epoch_retire(EpochThread *thread, void *ptr, Free destroy);
+void Epoch_collect(EpochThread *thread);
+
+#endif
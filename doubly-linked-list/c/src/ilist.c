@@ -0,0 +1,252 @@
+#include "alloc.h"
+#include "ilist.h"
+
+/*
+ * Internal helper functions
+ */
+static void IList_init(IList *list, ILink *link);
+
+/*
+ * Creates a new IList
+ */
+IList *IList_new(void) {
+    return LIST_CALLOC(1, sizeof(IList));
+}
+
+/*
+ * Free IList allocated memory, elements are owned by the caller
+ */
+void IList_free(IList *list) {
+    LIST_FREE(list);
+}
+
+/*
+ * IList is empty ?
+ */
+int IList_is_empty(IList *list) {
+    return list->head ? 0 : 1;
+}
+
+/*
+ * IList has some ILink ?
+ */
+int IList_has_some(IList *list) {
+    return list->head ? 1 : 0;
+}
+
+/*
+ * IList contains ILink ?
+ */
+int IList_contains(IList *list, ILink *link) {
+    return IList_get_index(list, link) >= 0;
+}
+
+/*
+ * Get ILink index
+ */
+int IList_get_index(IList *list, ILink *link) {
+    ILink *current = list->head;
+    for (int i = 0; current; i++) {
+        if (link == current) {
+            return i;
+        }
+        current = current->next;
+    }
+    return -1;
+}
+
+/*
+ * Get ILink at index
+ */
+ILink *IList_get_at(IList *list, int index) {
+    ILink *current = list->head;
+    for (int i = 0; current; i++) {
+        if (i == index) {
+            return current;
+        }
+        current = current->next;
+    }
+    return NULL;
+}
+
+/*
+ * IList init
+ */
+static void IList_init(IList *list, ILink *link) {
+    link->next = NULL;
+    link->prev = NULL;
+    list->head = link;
+    list->tail = link;
+    list->size = 1;
+}
+
+/*
+ * Add ILink to IList head
+ */
+void IList_add_head(IList *list, ILink *link) {
+    if (list->head) {
+        IList_add_before(list, list->head, link);
+    } else {
+        IList_init(list, link);
+    }
+}
+
+/*
+ * Add ILink to IList tail
+ */
+void IList_add_tail(IList *list, ILink *link) {
+    if (list->tail) {
+        IList_add_after(list, list->tail, link);
+    } else {
+        IList_init(list, link);
+    }
+}
+
+/*
+ * Add ILink before other link
+ */
+void IList_add_before(IList *list, ILink *ref, ILink *link) {
+    link->prev = ref->prev;
+    link->next = ref;
+    if (ref->prev) {
+        ref->prev->next = link;
+    } else {
+        list->head = link;
+    }
+    ref->prev = link;
+    list->size++;
+}
+
+/*
+ * Add ILink after other link
+ */
+void IList_add_after(IList *list, ILink *ref, ILink *link) {
+    link->prev = ref;
+    link->next = ref->next;
+    if (ref->next) {
+        ref->next->prev = link;
+    } else {
+        list->tail = link;
+    }
+    ref->next = link;
+    list->size++;
+}
+
+/*
+ * Add ILink at index
+ */
+ILink *IList_add_at(IList *list, int index, ILink *link) {
+    ILink *current = IList_get_at(list, index);
+    if (!current) {
+        return NULL;
+    }
+    IList_add_before(list, current, link);
+    return link;
+}
+
+/*
+ * Swap ILinks
+ */
+void IList_swap(IList *list, ILink *a, ILink *b) {
+    if (a == b->prev) {
+        IList_delete(list, b);
+        IList_add_before(list, a, b);
+
+    } else if (b == a->prev) {
+        IList_delete(list, a);
+        IList_add_before(list, b, a);
+
+    } else {
+        IList_delete(list, a);
+        IList_delete(list, b);
+
+        if (!a->next) {
+            ILink *temp = b->next;
+            IList_add_after(list, list->tail, b);
+            IList_add_before(list, temp, a);
+
+        } else if (!b->next) {
+            ILink *temp = a->next;
+            IList_add_after(list, list->tail, a);
+            IList_add_before(list, temp, b);
+
+        } else {
+            ILink *temp = a->next;
+            IList_add_before(list, b->next, a);
+            IList_add_before(list, temp, b);
+        }
+    }
+}
+
+/*
+ * Shift IList left
+ */
+void IList_shift_left(IList *list) {
+    ILink *link = list->head;
+    IList_delete(list, link);
+    IList_add_after(list, list->tail, link);
+}
+
+/*
+ * Shift IList right
+ */
+void IList_shift_right(IList *list) {
+    ILink *link = list->tail;
+    IList_delete(list, link);
+    IList_add_before(list, list->head, link);
+}
+
+/*
+ * Reverse IList by flipping every link in place
+ */
+void IList_reverse(IList *list) {
+    ILink *current = list->head;
+    while (current) {
+        ILink *next = current->next;
+        current->next = current->prev;
+        current->prev = next;
+        current = next;
+    }
+    ILink *temp = list->head;
+    list->head = list->tail;
+    list->tail = temp;
+}
+
+/*
+ * Unlink all ILinks, the elements themselves are left untouched
+ */
+void IList_clear(IList *list) {
+    list->head = NULL;
+    list->tail = NULL;
+    list->size = 0;
+}
+
+/*
+ * Unlink ILink from IList
+ */
+void IList_delete(IList *list, ILink *link) {
+    if (link->prev) {
+        link->prev->next = link->next;
+    } else {
+        list->head = link->next;
+    }
+
+    if (link->next) {
+        link->next->prev = link->prev;
+    } else {
+        list->tail = link->prev;
+    }
+
+    list->size--;
+}
+
+/*
+ * Unlink ILink at index from IList
+ */
+ILink *IList_delete_at(IList *list, int index) {
+    ILink *link = IList_get_at(list, index);
+    if (link) {
+        IList_delete(list, link);
+    }
+    return link;
+}
@@ -0,0 +1,56 @@
+#ifndef ILIST_H
+#define ILIST_H
+
+#include <stddef.h>
+#include <stdlib.h>
+
+/*
+ * Intrusive List: the ILink lives inside the caller's struct,
+ * so adding an element never allocates
+ */
+typedef struct ILink ILink;
+typedef struct IList IList;
+
+struct ILink {
+    ILink *next;
+    ILink *prev;
+};
+
+struct IList {
+    ILink *head;
+    ILink *tail;
+    size_t size;
+};
+
+/*
+ * Get the struct of given type containing an ILink member
+ */
+#define IList_entry(link, type, member) \
+    ((type *) ((char *) (link) - offsetof(type, member)))
+
+IList *IList_new(void);
+void IList_free(IList *list);
+
+int IList_is_empty(IList *list);
+int IList_contains(IList *list, ILink *link);
+int IList_has_some(IList *list);
+
+int IList_get_index(IList *list, ILink *link);
+ILink *IList_get_at(IList *list, int index);
+
+void IList_add_head(IList *list, ILink *link);
+void IList_add_tail(IList *list, ILink *link);
+void IList_add_before(IList *list, ILink *ref, ILink *link);
+void IList_add_after(IList *list, ILink *ref, ILink *link);
+ILink *IList_add_at(IList *list, int index, ILink *link);
+
+void IList_swap(IList *list, ILink *a, ILink *b);
+void IList_shift_left(IList *list);
+void IList_shift_right(IList *list);
+void IList_reverse(IList *list);
+
+void IList_clear(IList *list);
+void IList_delete(IList *list, ILink *link);
+ILink *IList_delete_at(IList *list, int index);
+
+#endif
@@ -1,44 +1,257 @@
+#if defined(LIST_STATS_PERF)
+#define _GNU_SOURCE
+#include <linux/perf_event.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+#include "alloc.h"
+#include "cache.h"
 #include "list.h"
 
+#define LIST_RUNS 64
+
+/*
+ * Table used by List_unique, with room for twice the elements
+ */
+typedef struct {
+    void **slots;
+    size_t mask;
+    Hash hash;
+    Compare compare;
+} ListSeen;
+
+#if defined(__GNUC__)
+#define LIST_PREFETCH(ptr) __builtin_prefetch(ptr)
+#else
+#define LIST_PREFETCH(ptr) ((void) (ptr))
+#endif
+
+/*
+ * Node cache shared by every cached List
+ */
+static Cache List_nodes = CACHE_INITIALIZER(sizeof(Node));
+
+#if defined(LIST_STATS_PERF) && !defined(LIST_STATS)
+#define LIST_STATS
+#endif
+
+/*
+ * Instrumentation, compiled out unless LIST_STATS is defined.
+ * Counters are per thread, so threads never race on them
+ */
+#ifdef LIST_STATS
+static _Thread_local ListStats List_counters;
+static _Thread_local int List_depth;
+#define LIST_COUNT(counter, n) (List_counters.counter += (n))
+#define LIST_CALL_BEGIN() List_call_begin()
+#define LIST_CALL_END() List_call_end()
+#else
+#define LIST_COUNT(counter, n) ((void) 0)
+#define LIST_CALL_BEGIN() ((void) 0)
+#define LIST_CALL_END() ((void) 0)
+#endif
+
 /*
  * Internal helper functions
  */
-static Node *List_node_new(void *data);
-static void List_node_free(Node *node);
+static Node *List_node_alloc(List *list);
+static Node *List_node_new(List *list, void *data);
+static void List_node_free(List *list, Node *node);
+static void List_node_release(List *list, Node *node);
 static Node *List_init(List *list, void *data);
+static void List_add_node_before(List *list, Node *node, Node *new);
+static void List_add_node_after(List *list, Node *node, Node *new);
 static void List_remove(List *list, Node *node);
+static void List_rank_free(List *list);
+static Rank *List_rank(List *list, Node *node);
+static void List_rank_new(List *list, Node *node);
+static void List_rank_move(List *list, Node *old, Node *node);
+static int List_alike(List *list, List *other);
+static Node *List_node_adopt(List *list, List *other, Node *node);
+static void List_move(List *list, Node *ref, List *other, Node *first, Node *last);
+static Node *List_merge(Node *a, Node *b, Compare compare);
+static void List_runs_push(Node *runs[], Node *run, Compare compare);
+static Node *List_runs_merge(Node *runs[], Compare compare);
+static void List_relink(List *list, Node *head);
+static void List_normalize(List *list);
+static int List_node_index(List *list, Node *node);
+static Node *List_node_at(List *list, int index);
+static void List_iter_advance(ListIter *iter);
+static Node *List_relocate(List *list, Pool *pool, Node *first, size_t count,
+                           Remap remap, void *arg);
+static Node *List_chain_new(List *list, void **data, size_t count);
+static void List_chain_link(List *list, Node *node, Node *first, Node *last, size_t count);
+static size_t List_sweep(List *list, Predicate predicate, void *arg, int keep);
+static int List_seen(void *data, void *arg);
+#ifdef LIST_STATS
+static void List_call_begin(void);
+static void List_call_end(void);
+#endif
+#ifdef LIST_STATS_PERF
+static int List_perf_open(uint64_t config, int group);
+static void List_perf_read(uint64_t values[2]);
+#endif
 
 /*
  * Creates a new List
  */
 List *List_new(Free free) {
-    List *list = calloc(1, sizeof(List));
+    List *list = LIST_CALLOC(1, sizeof(List));
     list->free = free;
     return list;
 }
 
+/*
+ * Creates a new List with Nodes allocated from a Pool,
+ * which may be shared with other Lists
+ */
+List *List_new_pooled(Free free, Pool *pool) {
+    List *list = List_new(free);
+    list->pool = Pool_retain(pool);
+    return list;
+}
+
+/*
+ * Creates a new List with Nodes taken from per thread caches,
+ * for Lists built and torn down by many threads at once
+ */
+List *List_new_cached(Free free) {
+    List *list = List_new(free);
+    list->cached = 1;
+    return list;
+}
+
 /*
  * Free List allocated memory
  */
 void List_free(List *list) {
     List_clear(list);
-    free(list);
+    List_unindex(list);
+    if (list->pool) {
+        Pool_free(list->pool);
+    }
+    LIST_FREE(list);
+}
+
+/*
+ * Keep an order statistic index over List nodes, making
+ * positional operations O(log n)
+ */
+void List_index(List *list) {
+    if (list->indexed) {
+        return;
+    }
+    list->lookup = RankMap_new();
+    list->indexed = 1;
+    Rank *last = NULL;
+    for (Node *node = list->head; node; node = node->next) {
+        List_rank_new(list, node);
+        Rank_append(&last, List_rank(list, node));
+    }
+    list->ranks = Rank_build(last);
+}
+
+/*
+ * Drop the order statistic index
+ */
+void List_unindex(List *list) {
+    if (!list->indexed) {
+        return;
+    }
+    List_rank_free(list);
+    RankMap_free(list->lookup);
+    list->lookup = NULL;
+    list->indexed = 0;
+}
+
+/*
+ * Free every Node Rank, leaving the index empty
+ */
+static void List_rank_free(List *list) {
+    if (!list->indexed) {
+        return;
+    }
+    for (size_t i = 0; i <= list->lookup->mask; i++) {
+        Rank_free(list->lookup->slots[i]);
+    }
+    RankMap_clear(list->lookup);
+    list->ranks = NULL;
+}
+
+/*
+ * Get Node Rank, kept by the index rather than the Node
+ * so unindexed Lists pay nothing for it
+ */
+static Rank *List_rank(List *list, Node *node) {
+    return RankMap_get(list->lookup, node);
+}
+
+/*
+ * Give Node a Rank, not yet in the tree
+ */
+static void List_rank_new(List *list, Node *node) {
+    RankMap_put(list->lookup, Rank_new(node));
+}
+
+/*
+ * Key the Rank of a Node moved from old by its new address
+ */
+static void List_rank_move(List *list, Node *old, Node *node) {
+    Rank *rank = list->indexed ? RankMap_remove(list->lookup, old) : NULL;
+    if (rank) {
+        rank->item = node;
+        RankMap_put(list->lookup, rank);
+    }
+}
+
+/*
+ * Allocate zeroed Node memory from wherever List allocates
+ */
+static Node *List_node_alloc(List *list) {
+    if (list->pool) {
+        return Pool_alloc(list->pool);
+    } else if (list->cached) {
+        return Cache_alloc(&List_nodes);
+    }
+    return LIST_CALLOC(1, sizeof(Node));
 }
 
 /*
  * Creates a new Node
  */
-static Node *List_node_new(void *data) {
-    Node *node = calloc(1, sizeof(Node));
+static Node *List_node_new(List *list, void *data) {
+    Node *node = List_node_alloc(list);
+    LIST_COUNT(allocs, 1);
     node->data = data;
+    if (list->indexed) {
+        List_rank_new(list, node);
+    }
     return node;
 }
 
 /*
  * Free Node allocated memory
  */
-static void List_node_free(Node *node) {
-    free(node);
+static void List_node_free(List *list, Node *node) {
+    if (list->indexed) {
+        Rank_free(RankMap_remove(list->lookup, node));
+    }
+    LIST_COUNT(frees, 1);
+    List_node_release(list, node);
+}
+
+/*
+ * Give Node memory back to wherever List allocates from
+ */
+static void List_node_release(List *list, Node *node) {
+    if (list->pool) {
+        Pool_release(list->pool, node);
+    } else if (list->cached) {
+        Cache_release(&List_nodes, node);
+    } else {
+        LIST_FREE(node);
+    }
 }
 
 /*
@@ -59,72 +272,273 @@ int List_has_some(List *list) {
  * List contains Node ?
  */
 int List_contains(List *list, Node *node) {
-    return List_get_index(list, node) >= 0;
+    return node && node->list == list;
+}
+
+/*
+ * Node a comes before Node b in List ? Uses the index when kept,
+ * otherwise walks forward from both until one meets the other
+ */
+int List_is_before(List *list, Node *a, Node *b) {
+    if (!List_contains(list, a) || !List_contains(list, b) || a == b) {
+        return 0;
+    }
+    if (list->reversed) {
+        Node *temp = a;
+        a = b;
+        b = temp;
+    }
+    if (list->indexed) {
+        return Rank_index(List_rank(list, a)) < Rank_index(List_rank(list, b));
+    }
+
+    Node *from_a = a;
+    Node *from_b = b;
+    while (from_a && from_b) {
+        from_a = from_a->next;
+        from_b = from_b->next;
+        if (from_a == b) {
+            return 1;
+        }
+        if (from_b == a) {
+            return 0;
+        }
+    }
+    return from_b ? 0 : 1;
 }
 
 /*
  * Get Node index
  */
 int List_get_index(List *list, Node *node) {
+    LIST_CALL_BEGIN();
+    int index = List_node_index(list, node);
+    LIST_CALL_END();
+    return list->reversed && index >= 0 ? (int) list->size - 1 - index : index;
+}
+
+/*
+ * Get Node at index
+ */
+Node *List_get_at(List *list, int index) {
+    LIST_CALL_BEGIN();
+    Node *node = List_node_at(list, list->reversed ? (int) list->size - 1 - index : index);
+    LIST_CALL_END();
+    return node;
+}
+
+/*
+ * Get first Node in view order
+ */
+Node *List_first(List *list) {
+    return list->reversed ? list->tail : list->head;
+}
+
+/*
+ * Get last Node in view order
+ */
+Node *List_last(List *list) {
+    return list->reversed ? list->head : list->tail;
+}
+
+/*
+ * Get Node following node in view order
+ */
+Node *List_next(List *list, Node *node) {
+    return list->reversed ? node->prev : node->next;
+}
+
+/*
+ * Get Node preceding node in view order
+ */
+Node *List_prev(List *list, Node *node) {
+    return list->reversed ? node->next : node->prev;
+}
+
+/*
+ * Start an iterator on the first Node in the given direction,
+ * filling its window. The Node last returned may be deleted
+ * while iterating, no other
+ */
+void List_iter(ListIter *iter, List *list, int flags) {
+    iter->backward = (flags & LIST_BACKWARD) ? !list->reversed : list->reversed;
+    iter->data = flags & LIST_PREFETCH_DATA;
+    iter->last = iter->backward ? list->tail : list->head;
+    iter->pos = 0;
+    iter->count = 0;
+
+    if (iter->last) {
+        LIST_PREFETCH(iter->last);
+        iter->ahead[iter->count++] = iter->last;
+    }
+    while (iter->last && iter->count < LIST_AHEAD) {
+        List_iter_advance(iter);
+    }
+}
+
+/*
+ * Find the Node after the last one in the window, prefetching it,
+ * and the data of the last one whose Node is loaded by now
+ */
+static void List_iter_advance(ListIter *iter) {
+    Node *last = iter->last;
+    if (iter->data) {
+        LIST_PREFETCH(last->data);
+    }
+    Node *node = iter->backward ? last->prev : last->next;
+    if (node) {
+        LIST_PREFETCH(node);
+        iter->ahead[(iter->pos + iter->count) % LIST_AHEAD] = node;
+        iter->count++;
+    }
+    iter->last = node;
+}
+
+/*
+ * Get next Node, NULL past the end
+ */
+Node *List_iter_next(ListIter *iter) {
+    if (!iter->count) {
+        return NULL;
+    }
+    Node *node = iter->ahead[iter->pos];
+    iter->pos = (iter->pos + 1) % LIST_AHEAD;
+    iter->count--;
+    if (iter->last) {
+        List_iter_advance(iter);
+    }
+    return node;
+}
+
+/*
+ * Call apply on every element in the given direction
+ */
+void List_foreach(List *list, Apply apply, void *arg, int flags) {
+    ListIter iter;
+    List_iter(&iter, list, flags);
+    Node *node;
+    while ((node = List_iter_next(&iter))) {
+        apply(node->data, arg);
+    }
+}
+
+/*
+ * Get Node position from head, remembering it in the cursor
+ */
+static int List_node_index(List *list, Node *node) {
+    if (!List_contains(list, node)) {
+        return -1;
+    }
+    if (node == list->current) {
+        return list->position;
+    }
+    if (list->indexed) {
+        return Rank_index(List_rank(list, node));
+    }
+
     Node *current = list->head;
     for (int i = 0; current; i++) {
         if (node == current) {
+            list->current = current;
+            list->position = i;
             return i;
         }
         current = current->next;
+        LIST_COUNT(steps, 1);
     }
     return -1;
 }
 
 /*
- * Get Node at index
+ * Get Node at position from head, walking from the nearest of
+ * head, tail or cursor, and leaving the cursor there
  */
-Node *List_get_at(List *list, int index) {
-    Node *current = list->head;
-    for (int i = 0; current; i++) {
-        if (i == index) {
-            return current;
+static Node *List_node_at(List *list, int index) {
+    if (index < 0 || (size_t) index >= list->size) {
+        return NULL;
+    }
+
+    Node *current;
+    int position;
+
+    if (list->indexed) {
+        current = Rank_select(list->ranks, index)->item;
+        position = index;
+
+    } else {
+        int last = list->size - 1;
+        if (index <= last - index) {
+            current = list->head;
+            position = 0;
+        } else {
+            current = list->tail;
+            position = last;
+        }
+        if (list->current && abs(list->position - index) < abs(position - index)) {
+            current = list->current;
+            position = list->position;
+        }
+        LIST_COUNT(steps, abs(position - index));
+
+        for (; position < index; position++) {
+            current = current->next;
+        }
+        for (; position > index; position--) {
+            current = current->prev;
         }
-        current = current->next;
     }
-    return NULL;
+
+    list->current = current;
+    list->position = position;
+    return current;
 }
 
 /*
  * List init
  */
 static Node *List_init(List *list, void *data) {
-    Node *new = List_node_new(data);
+    Node *new = List_node_new(list, data);
     list->head = new;
     list->tail = new;
     list->size = 1;
+    new->list = list;
+    if (list->indexed) {
+        Rank_insert_after(&list->ranks, NULL, List_rank(list, new));
+    }
     return new;
 }
 
 /*
- * Add Node to List head
+ * Add Node first in view order
  */
 Node *List_add_head(List *list, void *data) {
     if (list->head) {
-        return List_add_before(list, list->head, data);
+        return List_add_before(list, List_first(list), data);
     }
     return List_init(list, data);
 }
 
 /*
- * Add Node to List tail
+ * Add Node last in view order
  */
 Node *List_add_tail(List *list, void *data) {
     if (list->tail) {
-        return List_add_after(list, list->tail, data);
+        return List_add_after(list, List_last(list), data);
     }
     return List_init(list, data);
 }
 
 /*
- * Add Node before other node
+ * Add Node before other node, the cursor survives when it is
+ * that node or when every index shifts by one
  */
 static void List_add_node_before(List *list, Node *node, Node *new) {
+    if (list->current && (node == list->current || !node->prev)) {
+        list->position++;
+    } else {
+        list->current = NULL;
+    }
+
     new->prev = node->prev;
     new->next = node;
     if (node->prev) {
@@ -134,21 +548,34 @@ static void List_add_node_before(List *list, Node *node, Node *new) {
     }
     node->prev = new;
     list->size++;
+    new->list = list;
+    if (list->indexed) {
+        Rank_insert_before(&list->ranks, List_rank(list, node), List_rank(list, new));
+    }
 }
 
 /*
- * Add Node before other node
+ * Add Node before other node in view order
  */
 Node *List_add_before(List *list, Node *node, void *data) {
-    Node *new = List_node_new(data);
-    List_add_node_before(list, node, new);
+    Node *new = List_node_new(list, data);
+    if (list->reversed) {
+        List_add_node_after(list, node, new);
+    } else {
+        List_add_node_before(list, node, new);
+    }
     return new;
 }
 
 /*
- * Add Node after other node
+ * Add Node after other node, the cursor survives when it is
+ * that node or when no index shifts
  */
 static void List_add_node_after(List *list, Node *node, Node *new) {
+    if (node != list->current && node->next) {
+        list->current = NULL;
+    }
+
     new->prev = node;
     new->next = node->next;
     if (node->next) {
@@ -158,37 +585,173 @@ static void List_add_node_after(List *list, Node *node, Node *new) {
     }
     node->next = new;
     list->size++;
+    new->list = list;
+    if (list->indexed) {
+        Rank_insert_after(&list->ranks, List_rank(list, node), List_rank(list, new));
+    }
 }
 
 /*
- * Add Node after other node
+ * Add Node after other node in view order
  */
 Node *List_add_after(List *list, Node *node, void *data) {
-    Node *new = List_node_new(data);
-    List_add_node_after(list, node, new);
+    Node *new = List_node_new(list, data);
+    if (list->reversed) {
+        List_add_node_before(list, node, new);
+    } else {
+        List_add_node_after(list, node, new);
+    }
     return new;
 }
 
 /*
- * Add Node at index
+ * Creates count Nodes holding data in view order, linked by next
+ * and prev from the first returned on, taken from one block when
+ * List is pooled
  */
-Node *List_add_at(List *list, int index, void *data) {
-    Node *current = list->head;
+static Node *List_chain_new(List *list, void **data, size_t count) {
+    Node *block = list->pool ? Pool_alloc_many(list->pool, count) : NULL;
+    Node *first = NULL;
+    Node *prev = NULL;
 
-    for (int i = 0; current; i++) {
-        if (i == index) {
-            return List_add_before(list, current, data);
+    for (size_t i = 0; i < count; i++) {
+        Node *node = block ? &block[i] : List_node_alloc(list);
+        node->data = data[list->reversed ? count - 1 - i : i];
+        node->prev = prev;
+        node->list = list;
+        if (list->indexed) {
+            List_rank_new(list, node);
+        }
+        if (prev) {
+            prev->next = node;
+        } else {
+            first = node;
+        }
+        prev = node;
+    }
+    LIST_COUNT(allocs, count);
+    return first;
+}
+
+/*
+ * Splice a chain of count new Nodes in after node, or at
+ * the head when node is NULL, in one go
+ */
+static void List_chain_link(List *list, Node *node, Node *first, Node *last, size_t count) {
+    Node *next = node ? node->next : list->head;
+    if (!node && list->current) {
+        list->position += count;
+    } else if (node && node != list->current && next) {
+        list->current = NULL;
+    }
+
+    first->prev = node;
+    last->next = next;
+    if (node) {
+        node->next = first;
+    } else {
+        list->head = first;
+    }
+    if (next) {
+        next->prev = last;
+    } else {
+        list->tail = last;
+    }
+    list->size += count;
+
+    if (!list->indexed) {
+        return;
+    }
+    for (Node *current = first; current != next; current = current->next) {
+        if (current->prev) {
+            Rank_insert_after(&list->ranks, List_rank(list, current->prev), List_rank(list, current));
+        } else if (next) {
+            Rank_insert_before(&list->ranks, List_rank(list, next), List_rank(list, current));
+        } else {
+            Rank_insert_after(&list->ranks, NULL, List_rank(list, current));
+        }
+    }
+}
+
+/*
+ * Add count elements after node in view order, or first when
+ * node is NULL, returning the Node holding the first element
+ */
+Node *List_add_after_many(List *list, Node *node, void **data, size_t count) {
+    if (!count) {
+        return NULL;
+    }
+    Node *first = List_chain_new(list, data, count);
+    Node *last = first;
+    for (size_t i = 1; i < count; i++) {
+        last = last->next;
+    }
+    if (list->reversed) {
+        List_chain_link(list, node ? node->prev : list->tail, first, last, count);
+        return last;
+    }
+    List_chain_link(list, node, first, last, count);
+    return first;
+}
+
+/*
+ * Add count elements last in view order, returning the Node
+ * holding the first element
+ */
+Node *List_add_tail_many(List *list, void **data, size_t count) {
+    return List_add_after_many(list, List_last(list), data, count);
+}
+
+/*
+ * Creates a new List holding count elements, its Nodes in one
+ * block of pool, which may be shared with other Lists, or from
+ * the default allocator when pool is NULL
+ */
+List *List_from_array(void **data, size_t count, Free free, Pool *pool) {
+    List *list = pool ? List_new_pooled(free, pool) : List_new(free);
+    List_add_tail_many(list, data, count);
+    return list;
+}
+
+/*
+ * Copy List data to array, which holds list->size items,
+ * in view order
+ */
+size_t List_to_array(List *list, void **array) {
+    size_t i = 0;
+    if (list->reversed) {
+        for (Node *node = list->tail; node; node = node->prev) {
+            array[i++] = node->data;
+        }
+    } else {
+        for (Node *node = list->head; node; node = node->next) {
+            array[i++] = node->data;
         }
-        current = current->next;
     }
+    return i;
+}
 
-    return NULL;
+/*
+ * Add Node at index
+ */
+Node *List_add_at(List *list, int index, void *data) {
+    LIST_CALL_BEGIN();
+    Node *current = List_get_at(list, index);
+    Node *new = NULL;
+    if (current) {
+        new = List_add_before(list, current, data);
+    }
+    LIST_CALL_END();
+    return new;
 }
 
 /*
- * Swap Nodes
+ * Swap Nodes, a cursor on either follows its position
  */
 void List_swap(List *list, Node *a, Node *b) {
+    Node *current = list->current;
+    int position = list->position;
+
     if (a == b->prev) {
         List_remove(list, b);
         List_add_node_before(list, a, b);
@@ -217,53 +780,603 @@ void List_swap(List *list, Node *a, Node *b) {
             List_add_node_before(list, temp, b);
         }
     }
+
+    list->current = current == a ? b : current == b ? a : current;
+    list->position = position;
+}
+
+/*
+ * Rotate List left by k positions, or right if k is negative,
+ * relinking only the old and new ends
+ */
+void List_rotate(List *list, int k) {
+    int size = list->size;
+    if (list->reversed) {
+        k = -k;
+    }
+    if (size < 2 || (k %= size) == 0) {
+        return;
+    }
+    if (k < 0) {
+        k += size;
+    }
+
+    Node *head = list->head;
+    if (k <= size - k) {
+        for (int i = 0; i < k; i++) {
+            head = head->next;
+        }
+    } else {
+        head = list->tail;
+        for (int i = 1; i < size - k; i++) {
+            head = head->prev;
+        }
+    }
+
+    Node *old = list->head;
+    list->tail->next = list->head;
+    list->head->prev = list->tail;
+    list->tail = head->prev;
+    list->tail->next = NULL;
+    list->head = head;
+    head->prev = NULL;
+    if (list->current) {
+        list->position = (list->position - k + size) % size;
+    }
+
+    if (!list->indexed) {
+        return;
+    }
+    if (k <= size - k) {
+        for (Node *node = old; node; node = node->next) {
+            Rank_remove(&list->ranks, List_rank(list, node));
+            Rank_insert_after(&list->ranks, List_rank(list, node->prev), List_rank(list, node));
+        }
+    } else {
+        for (Node *node = old->prev; node; node = node->prev) {
+            Rank_remove(&list->ranks, List_rank(list, node));
+            Rank_insert_before(&list->ranks, List_rank(list, node->next), List_rank(list, node));
+        }
+    }
+}
+
+/*
+ * Lists allocate Nodes alike, so Nodes can move between them ?
+ */
+static int List_alike(List *list, List *other) {
+    return list->pool == other->pool && list->cached == other->cached;
+}
+
+/*
+ * Copy Node into memory from list's allocator when other allocates
+ * differently, relinking its neighbours in other, and release the
+ * old memory to other's. Returns the Node to keep using
+ */
+static Node *List_node_adopt(List *list, List *other, Node *node) {
+    if (List_alike(list, other)) {
+        return node;
+    }
+
+    Node *new = List_node_alloc(list);
+    *new = *node;
+    if (new->prev) {
+        new->prev->next = new;
+    } else {
+        other->head = new;
+    }
+    if (new->next) {
+        new->next->prev = new;
+    } else {
+        other->tail = new;
+    }
+    List_rank_move(other, node, new);
+    if (other->current == node) {
+        other->current = new;
+    }
+    LIST_COUNT(allocs, 1);
+    LIST_COUNT(frees, 1);
+    List_node_release(other, node);
+    return new;
+}
+
+/*
+ * Move the [first, last] range of other before ref in list, or to
+ * its tail if ref is NULL. Only the range ends are relinked, but the
+ * range is walked once to count and retag it, copying its Nodes when
+ * the Lists allocate them differently. Both lists share the same Free
+ */
+static void List_move(List *list, Node *ref, List *other, Node *first, Node *last) {
+    size_t count = 0;
+    for (Node *node = first; ; node = node->next) {
+        int end = node == last;
+        node = List_node_adopt(list, other, node);
+        if (!count) {
+            first = node;
+        }
+        if (end) {
+            last = node;
+        }
+        count++;
+        node->list = list;
+        Rank *rank = other->indexed ? RankMap_remove(other->lookup, node) : NULL;
+        if (rank) {
+            Rank_remove(&other->ranks, rank);
+        }
+        if (list->indexed) {
+            RankMap_put(list->lookup, rank ? rank : Rank_new(node));
+        } else {
+            Rank_free(rank);
+        }
+        if (end) {
+            break;
+        }
+    }
+
+    if (first->prev) {
+        first->prev->next = last->next;
+    } else {
+        other->head = last->next;
+    }
+    if (last->next) {
+        last->next->prev = first->prev;
+    } else {
+        other->tail = first->prev;
+    }
+    other->size -= count;
+    other->current = NULL;
+
+    if (ref && ref->prev) {
+        list->current = NULL;
+    } else if (ref && list->current) {
+        list->position += count;
+    }
+
+    Node *prev = ref ? ref->prev : list->tail;
+    first->prev = prev;
+    last->next = ref;
+    if (prev) {
+        prev->next = first;
+    } else {
+        list->head = first;
+    }
+    if (ref) {
+        ref->prev = last;
+    } else {
+        list->tail = last;
+    }
+    list->size += count;
+
+    if (!list->indexed) {
+        return;
+    }
+    for (Node *node = first; node != ref; node = node->next) {
+        if (node->prev) {
+            Rank_insert_after(&list->ranks, List_rank(list, node->prev), List_rank(list, node));
+        } else if (ref) {
+            Rank_insert_before(&list->ranks, List_rank(list, ref), List_rank(list, node));
+        } else {
+            Rank_insert_after(&list->ranks, NULL, List_rank(list, node));
+        }
+    }
+}
+
+/*
+ * Move the [first, last] range of other into list, before ref
+ * or at tail if ref is NULL. Returns 0, moving nothing, when the
+ * Lists have different Free functions or ref lies inside the range
+ */
+int List_splice(List *list, Node *ref, List *other, Node *first, Node *last) {
+    if (list->free != other->free) {
+        return 0;
+    }
+    if (list == other && ref) {
+        for (Node *node = first; node != last->next; node = node->next) {
+            if (node == ref) {
+                return 0;
+            }
+        }
+    }
+    List_normalize(list);
+    List_normalize(other);
+    List_move(list, ref, other, first, last);
+    return 1;
+}
+
+/*
+ * Move all other Nodes to list tail. Returns 0, moving nothing,
+ * when the Lists have different Free functions
+ */
+int List_concat(List *list, List *other) {
+    if (list->free != other->free) {
+        return 0;
+    }
+    List_normalize(list);
+    List_normalize(other);
+    if (other->head) {
+        List_move(list, NULL, other, other->head, other->tail);
+    }
+    return 1;
+}
+
+/*
+ * Split List at index, moving Nodes from index on to a new List
+ */
+List *List_split_at(List *list, int index) {
+    if (index < 0 || (size_t) index > list->size) {
+        return NULL;
+    }
+    List_normalize(list);
+
+    List *other = List_new(list->free);
+    if (list->pool) {
+        other->pool = Pool_retain(list->pool);
+    }
+    other->cached = list->cached;
+    if ((size_t) index == list->size) {
+        return other;
+    }
+
+    Node *current = list->current;
+    int position = list->position;
+    List_move(other, NULL, list, List_get_at(list, index), list->tail);
+    if (current && position < index) {
+        list->current = current;
+        list->position = position;
+    }
+    return other;
 }
 
 /*
  * Shift List left
  */
 void List_shift_left(List *list) {
-    Node *node = list->head;
-    List_remove(list, node);
-    List_add_node_after(list, list->tail, node);
+    List_rotate(list, 1);
 }
 
 /*
  * Shift List right
  */
 void List_shift_right(List *list) {
-    Node *node = list->tail;
-    List_remove(list, node);
-    List_add_node_before(list, list->head, node);
+    List_rotate(list, -1);
 }
 
 /*
- * Reverse List
+ * Reverse List in a single pass, flipping the links of every Node
  */
 void List_reverse(List *list) {
-    Node *a = list->head;
-    Node *b = list->tail;
-    while (a && b && a != b) {
-        List_swap(list, a, b);
-        Node *temp = a->prev;
-        a = b->next;
-        b = temp;
+    Node *node = list->head;
+    while (node) {
+        Node *next = node->next;
+        node->next = node->prev;
+        node->prev = next;
+        node = next;
+    }
+
+    Node *temp = list->head;
+    list->head = list->tail;
+    list->tail = temp;
+    if (list->current) {
+        list->position = list->size - 1 - list->position;
+    }
+
+    if (list->indexed) {
+        Rank *last = NULL;
+        for (node = list->head; node; node = node->next) {
+            Rank_append(&last, List_rank(list, node));
+        }
+        list->ranks = Rank_build(last);
+    }
+}
+
+/*
+ * Reverse List view in O(1): index, iteration and add functions
+ * see the List backwards, while head, tail and links stay in place.
+ * Functions moving Nodes between Lists reverse it for real first
+ */
+void List_flip(List *list) {
+    list->reversed = !list->reversed;
+}
+
+/*
+ * Move count Nodes from first on into one new block of Pool, in
+ * List order, fixing up links, cursor and ranks and reporting each
+ * move to remap. Returns the Node following them
+ */
+static Node *List_relocate(List *list, Pool *pool, Node *first, size_t count,
+                           Remap remap, void *arg) {
+    size_t length = 0;
+    for (Node *node = first; node && length < count; node = node->next) {
+        length++;
+    }
+    if (!length) {
+        return NULL;
+    }
+
+    Node *block = Pool_alloc_many(pool, length);
+    Node *node = first;
+    for (size_t i = 0; i < length; i++) {
+        Node *moved = &block[i];
+        Node *next = node->next;
+        *moved = *node;
+
+        if (moved->prev) {
+            moved->prev->next = moved;
+        } else {
+            list->head = moved;
+        }
+        if (moved->next) {
+            moved->next->prev = moved;
+        } else {
+            list->tail = moved;
+        }
+        if (list->current == node) {
+            list->current = moved;
+        }
+        List_rank_move(list, node, moved);
+        if (remap) {
+            remap(node, moved, arg);
+        }
+
+        List_node_release(list, node);
+        node = next;
+    }
+    return node;
+}
+
+/*
+ * Move every Node into one contiguous block in List order, so
+ * scans run sequentially through memory. Node pointers change,
+ * remap, when given, is told each old and new address. A List
+ * owning its Pool moves to a fresh Pool and frees the old one,
+ * otherwise the chunks left empty are freed. A List not pooled
+ * yet gets a Pool of its own, so moving its Nodes to Lists
+ * allocating otherwise copies them
+ */
+void List_compact(List *list, Remap remap, void *arg) {
+    Pool *old = list->pool;
+    if (old && (old->refs > 1 || old->used != list->size)) {
+        List_relocate(list, old, list->head, list->size, remap, arg);
+        Pool_trim(old);
+        return;
+    }
+
+    Pool *pool = Pool_new(sizeof(Node), old ? old->count : 4096);
+    List_relocate(list, pool, list->head, list->size, remap, arg);
+    if (old) {
+        Pool_free(old);
+    }
+    list->pool = pool;
+    list->cached = 0;
+}
+
+/*
+ * Compact count Nodes from first on, returning the Node to resume
+ * from, NULL once past the tail, when the chunks left empty are
+ * freed. Run in small steps from the head during idle time, it
+ * leaves the List in consecutive blocks. A List not pooled yet
+ * is compacted whole instead
+ */
+Node *List_compact_range(List *list, Node *first, size_t count, Remap remap, void *arg) {
+    if (!list->pool) {
+        List_compact(list, remap, arg);
+        return NULL;
+    }
+    Node *next = List_relocate(list, list->pool, first, count, remap, arg);
+    if (!next) {
+        Pool_trim(list->pool);
+    }
+    return next;
+}
+
+/*
+ * Turn a reversed view into a real reversal
+ */
+static void List_normalize(List *list) {
+    if (list->reversed) {
+        List_reverse(list);
+        list->reversed = 0;
     }
 }
 
 /*
- * Clear List nodes
+ * Merge two sorted chains linked by next only, taking from a on ties
+ */
+static Node *List_merge(Node *a, Node *b, Compare compare) {
+    Node head;
+    Node *tail = &head;
+    while (a && b) {
+        if (compare(b->data, a->data) < 0) {
+            tail->next = b;
+            b = b->next;
+        } else {
+            tail->next = a;
+            a = a->next;
+        }
+        tail = tail->next;
+    }
+    tail->next = a ? a : b;
+    return head.next;
+}
+
+/*
+ * Push a sorted run into a binary counter of pending runs, where
+ * slot i holds about 2^i runs and older runs sit in higher slots
+ */
+static void List_runs_push(Node *runs[], Node *run, Compare compare) {
+    int i = 0;
+    for (; runs[i]; i++) {
+        run = List_merge(runs[i], run, compare);
+        runs[i] = NULL;
+    }
+    runs[i] = run;
+}
+
+/*
+ * Merge all pending runs, oldest first
+ */
+static Node *List_runs_merge(Node *runs[], Compare compare) {
+    Node *head = NULL;
+    for (int i = 0; i < LIST_RUNS; i++) {
+        if (runs[i]) {
+            head = head ? List_merge(runs[i], head, compare) : runs[i];
+        }
+    }
+    return head;
+}
+
+/*
+ * Make a chain linked by next only the whole List, restoring
+ * prev links, tail, owner tags and index
+ */
+static void List_relink(List *list, Node *head) {
+    Node *prev = NULL;
+    Rank *last = NULL;
+    size_t size = 0;
+
+    for (Node *node = head; node; node = node->next) {
+        node->prev = prev;
+        node->list = list;
+        if (list->indexed) {
+            Rank *rank = List_rank(list, node);
+            if (!rank) {
+                rank = Rank_new(node);
+                RankMap_put(list->lookup, rank);
+            }
+            Rank_append(&last, rank);
+        }
+        prev = node;
+        size++;
+    }
+
+    list->head = head;
+    list->tail = prev;
+    list->size = size;
+    list->current = NULL;
+    if (list->indexed) {
+        list->ranks = Rank_build(last);
+    }
+}
+
+/*
+ * Sort List in place with a stable bottom-up merge sort over
+ * natural runs, so presorted input takes a single pass
+ */
+void List_sort(List *list, Compare compare) {
+    Node *runs[LIST_RUNS] = { NULL };
+
+    List_normalize(list);
+    Node *node = list->head;
+    while (node) {
+        Node *run = node;
+        Node *last = node;
+        node = node->next;
+        run->next = NULL;
+
+        if (node && compare(node->data, run->data) < 0) {
+            while (node && compare(node->data, run->data) < 0) {
+                Node *next = node->next;
+                node->next = run;
+                run = node;
+                node = next;
+            }
+        } else {
+            while (node && compare(node->data, last->data) >= 0) {
+                last->next = node;
+                last = node;
+                node = node->next;
+            }
+            last->next = NULL;
+        }
+
+        List_runs_push(runs, run, compare);
+    }
+    List_relink(list, List_runs_merge(runs, compare));
+}
+
+/*
+ * Merge sorted Lists into a sorted list, emptying them. Lists
+ * with a Free other than list's are left alone. Lists are merged
+ * pairwise, so k Lists cost O(n log k)
+ */
+void List_merge_sorted(List *list, List *others[], int count, Compare compare) {
+    Node *runs[LIST_RUNS] = { NULL };
+
+    List_normalize(list);
+    if (list->head) {
+        List_runs_push(runs, list->head, compare);
+    }
+    for (int i = 0; i < count; i++) {
+        List *other = others[i];
+        if (other->free != list->free) {
+            continue;
+        }
+        List_normalize(other);
+        if (!other->head) {
+            continue;
+        }
+        for (Node *node = other->head; node; node = node->next) {
+            node = List_node_adopt(list, other, node);
+        }
+        List_rank_free(other);
+        List_runs_push(runs, other->head, compare);
+        other->head = NULL;
+        other->tail = NULL;
+        other->current = NULL;
+        other->size = 0;
+    }
+    List_relink(list, List_runs_merge(runs, compare));
+}
+
+/*
+ * Clear List nodes, without unlinking them one by one:
+ * destructors run in one pass, then Node memory is released
+ * in bulk when the Pool holds no other live Nodes
  */
 void List_clear(List *list) {
-    while (list->head) {
-        List_delete(list, list->head);
+    Node *node = list->head;
+
+    List_rank_free(list);
+    if (list->free) {
+        for (Node *current = node; current; current = current->next) {
+            list->free(current->data);
+        }
+        LIST_COUNT(destructors, list->size);
+    }
+
+    if (list->pool && list->pool->used == list->size) {
+        LIST_COUNT(frees, list->size);
+        Pool_clear(list->pool);
+    } else {
+        while (node) {
+            Node *next = node->next;
+            List_node_free(list, node);
+            node = next;
+        }
     }
+
+    list->head = NULL;
+    list->tail = NULL;
+    list->current = NULL;
+    list->position = 0;
+    list->size = 0;
 }
 
 /*
- * Remove Node from List
+ * Remove Node from List, a cursor on it moves to a neighbour,
+ * any other survives only when removing head or tail
  */
 static void List_remove(List *list, Node *node) {
+    if (node == list->current && node->next) {
+        list->current = node->next;
+    } else if (node == list->current && node->prev) {
+        list->current = node->prev;
+        list->position--;
+    } else if (node == list->current || (node->prev && node->next)) {
+        list->current = NULL;
+    } else if (!node->prev && list->current) {
+        list->position--;
+    }
+
     if (node->prev) {
         node->prev->next = node->next;
     } else {
@@ -277,6 +1390,10 @@ static void List_remove(List *list, Node *node) {
     }
 
     list->size--;
+    node->list = NULL;
+    if (list->indexed) {
+        Rank_remove(&list->ranks, List_rank(list, node));
+    }
 }
 
 /*
@@ -284,8 +1401,11 @@ static void List_remove(List *list, Node *node) {
  */
 void List_delete(List *list, Node *node) {
     List_remove(list, node);
-    list->free(node->data);
-    List_node_free(node);
+    if (list->free) {
+        list->free(node->data);
+        LIST_COUNT(destructors, 1);
+    }
+    List_node_free(list, node);
 }
 
 /*
@@ -295,3 +1415,189 @@ void List_delete_at(List *list, int index) {
     Node *node = List_get_at(list, index);
     List_delete(list, node);
 }
+
+/*
+ * Delete in one pass, in view order, every element whose match
+ * by predicate differs from keep. Each Node is freed right after
+ * unlinking, while still in cache
+ */
+static size_t List_sweep(List *list, Predicate predicate, void *arg, int keep) {
+    size_t count = 0;
+    Node *node = List_first(list);
+    while (node) {
+        Node *next = List_next(list, node);
+        if ((predicate(node->data, arg) ? 1 : 0) != keep) {
+            List_delete(list, node);
+            count++;
+        }
+        node = next;
+    }
+    return count;
+}
+
+/*
+ * Delete every element matching predicate in one pass,
+ * returning how many were deleted
+ */
+size_t List_delete_if(List *list, Predicate predicate, void *arg) {
+    return List_sweep(list, predicate, arg, 0);
+}
+
+/*
+ * Keep only the elements matching predicate, in one pass,
+ * returning how many were deleted
+ */
+size_t List_filter(List *list, Predicate predicate, void *arg) {
+    return List_sweep(list, predicate, arg, 1);
+}
+
+/*
+ * Element already seen ? Remember it otherwise
+ */
+static int List_seen(void *data, void *arg) {
+    ListSeen *seen = arg;
+    if (!data) {
+        return 0;
+    }
+    size_t slot = seen->hash(data) & seen->mask;
+    while (seen->slots[slot]) {
+        if (!seen->compare(seen->slots[slot], data)) {
+            return 1;
+        }
+        slot = (slot + 1) & seen->mask;
+    }
+    seen->slots[slot] = data;
+    return 0;
+}
+
+/*
+ * Delete elements equal, by compare returning 0, to one earlier in
+ * view order, in O(n) expected time with a hash table keyed by hash.
+ * NULL data is never deleted. Returns how many were deleted
+ */
+size_t List_unique(List *list, Hash hash, Compare compare) {
+    size_t capacity = 2;
+    while (capacity < list->size * 2) {
+        capacity *= 2;
+    }
+
+    ListSeen seen = { LIST_CALLOC(capacity, sizeof(void *)), capacity - 1, hash, compare };
+    size_t count = List_sweep(list, List_seen, &seen, 0);
+    LIST_FREE(seen.slots);
+    return count;
+}
+
+/*
+ * Return this thread's cached Nodes to the depot shared by every
+ * thread, e.g. before it goes idle
+ */
+void List_cache_flush(void) {
+    Cache_flush(&List_nodes);
+}
+
+/*
+ * Free the Nodes held by the depot, returning how many. Nodes
+ * still cached by threads are freed once flushed and trimmed
+ */
+size_t List_cache_trim(void) {
+    return Cache_trim(&List_nodes);
+}
+
+/*
+ * Snapshot this thread's List counters, all zero when built
+ * without LIST_STATS
+ */
+void List_stats(ListStats *stats) {
+#ifdef LIST_STATS
+    *stats = List_counters;
+#else
+    ListStats none = { 0 };
+    *stats = none;
+#endif
+}
+
+/*
+ * Reset this thread's List counters
+ */
+void List_stats_reset(void) {
+#ifdef LIST_STATS
+    ListStats none = { 0 };
+    List_counters = none;
+#endif
+}
+
+#ifdef LIST_STATS
+#ifdef LIST_STATS_PERF
+static _Thread_local uint64_t List_perf_start[2];
+#endif
+
+/*
+ * Enter an instrumented call, sampling hardware counters
+ * on the outermost one only
+ */
+static void List_call_begin(void) {
+    if (List_depth++) {
+        return;
+    }
+    List_counters.calls++;
+#ifdef LIST_STATS_PERF
+    List_perf_read(List_perf_start);
+#endif
+}
+
+/*
+ * Leave an instrumented call, adding the hardware counter deltas
+ */
+static void List_call_end(void) {
+    if (--List_depth) {
+        return;
+    }
+#ifdef LIST_STATS_PERF
+    uint64_t end[2];
+    List_perf_read(end);
+    List_counters.cycles += end[0] - List_perf_start[0];
+    List_counters.cache_misses += end[1] - List_perf_start[1];
+#endif
+}
+#endif
+
+#ifdef LIST_STATS_PERF
+static _Thread_local int List_perf_fd = -2;
+
+/*
+ * Open a user space hardware counter for this thread
+ */
+static int List_perf_open(uint64_t config, int group) {
+    struct perf_event_attr attr = { 0 };
+    attr.type = PERF_TYPE_HARDWARE;
+    attr.size = sizeof(attr);
+    attr.config = config;
+    attr.read_format = PERF_FORMAT_GROUP;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    return syscall(__NR_perf_event_open, &attr, 0, -1, group, 0);
+}
+
+/*
+ * Read cycles and cache misses, opening the counters on first
+ * use. Both stay zero when perf events are unavailable
+ */
+static void List_perf_read(uint64_t values[2]) {
+    if (List_perf_fd == -2) {
+        List_perf_fd = List_perf_open(PERF_COUNT_HW_CPU_CYCLES, -1);
+        if (List_perf_fd >= 0 && List_perf_open(PERF_COUNT_HW_CACHE_MISSES, List_perf_fd) < 0) {
+            close(List_perf_fd);
+            List_perf_fd = -1;
+        }
+    }
+
+    struct { uint64_t count; uint64_t values[2]; } group;
+    if (List_perf_fd < 0 || read(List_perf_fd, &group, sizeof(group)) != sizeof(group)) {
+        values[0] = 0;
+        values[1] = 0;
+        return;
+    }
+    values[0] = group.values[0];
+    values[1] = group.values[1];
+}
+#endif
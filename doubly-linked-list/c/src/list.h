@@ -1,49 +1,152 @@
 #ifndef LIST_H
 #define LIST_H
 
+#include <stdint.h>
 #include <stdlib.h>
 
+#include "pool.h"
+#include "rank.h"
+
 typedef struct Node Node;
 typedef struct List List;
+typedef struct ListStats ListStats;
+typedef struct ListIter ListIter;
 typedef void (*Free)(void*);
+typedef int (*Compare)(const void*, const void*);
+typedef void (*Apply)(void *data, void *arg);
+typedef void (*Remap)(Node *old, Node *node, void *arg);
+typedef int (*Predicate)(void *data, void *arg);
+typedef size_t (*Hash)(const void *data);
+
+/*
+ * Iteration flags: direction is relative to the List view
+ */
+#define LIST_FORWARD 0
+#define LIST_BACKWARD 1
+#define LIST_PREFETCH_DATA 2
+
+#define LIST_AHEAD 8
 
 struct Node {
     void *data;
     Node *next;
     Node *prev;
+    List *list;
 };
 
 struct List {
     Node *head;
     Node *tail;
     Node *current;
+    int position;
     size_t size;
     Free free;
+    Pool *pool;
+    int cached;
+    Rank *ranks;
+    RankMap *lookup;
+    int indexed;
+    int reversed;
+};
+
+/*
+ * Iterator walking LIST_AHEAD Nodes ahead of the one it returns,
+ * prefetching each as it is found and, with LIST_PREFETCH_DATA,
+ * its data too
+ */
+struct ListIter {
+    Node *ahead[LIST_AHEAD];
+    Node *last;
+    int pos;
+    int count;
+    int backward;
+    int data;
+};
+
+/*
+ * Counters kept per thread across all Lists when built with
+ * -DLIST_STATS, cycles and cache misses also with -DLIST_STATS_PERF
+ * on Linux
+ */
+struct ListStats {
+    size_t allocs;
+    size_t frees;
+    size_t steps;
+    size_t destructors;
+    size_t calls;
+    uint64_t cycles;
+    uint64_t cache_misses;
 };
 
 List *List_new(void (*free)(void *data));
+List *List_new_pooled(void (*free)(void *data), Pool *pool);
+List *List_new_cached(void (*free)(void *data));
+List *List_from_array(void **data, size_t count, void (*free)(void *data), Pool *pool);
 void List_free(List *list);
 
+void List_index(List *list);
+void List_unindex(List *list);
+
 int List_is_empty(List *list);
 int List_contains(List *list, Node *node);
 int List_has_some(List *list);
+int List_is_before(List *list, Node *a, Node *b);
 
 int List_get_index(List *list, Node *node);
 Node *List_get_at(List *list, int index);
 
+Node *List_first(List *list);
+Node *List_last(List *list);
+Node *List_next(List *list, Node *node);
+Node *List_prev(List *list, Node *node);
+
+void List_iter(ListIter *iter, List *list, int flags);
+Node *List_iter_next(ListIter *iter);
+void List_foreach(List *list, Apply apply, void *arg, int flags);
+
 Node *List_add_head(List *list, void *data);
 Node *List_add_tail(List *list, void *data);
 Node *List_add_before(List *list, Node *ref, void *data);
 Node *List_add_after(List *list, Node *ref, void *data);
 Node *List_add_at(List *list, int index, void *data);
+Node *List_add_tail_many(List *list, void **data, size_t count);
+Node *List_add_after_many(List *list, Node *node, void **data, size_t count);
+size_t List_to_array(List *list, void **array);
 
 void List_swap(List *list, Node *a, Node *b);
 void List_shift_left(List *list);
 void List_shift_right(List *list);
 void List_reverse(List *list);
+void List_flip(List *list);
+void List_rotate(List *list, int k);
+
+/*
+ * Moving Nodes between Lists requires both to share the same Free,
+ * otherwise nothing moves and 0 is returned. Nodes of a List allocating
+ * them otherwise, from another Pool or the cache, are copied into the
+ * destination's allocator as they move, so pointers to them become invalid
+ */
+int List_splice(List *list, Node *ref, List *other, Node *first, Node *last);
+int List_concat(List *list, List *other);
+List *List_split_at(List *list, int index);
+
+void List_compact(List *list, Remap remap, void *arg);
+Node *List_compact_range(List *list, Node *first, size_t count, Remap remap, void *arg);
+
+void List_sort(List *list, Compare compare);
+void List_merge_sorted(List *list, List *others[], int count, Compare compare);
 
 void List_clear(List *list);
 void List_delete(List *list, Node *node);
 void List_delete_at(List *list, int index);
+size_t List_delete_if(List *list, Predicate predicate, void *arg);
+size_t List_filter(List *list, Predicate predicate, void *arg);
+size_t List_unique(List *list, Hash hash, Compare compare);
+
+void List_cache_flush(void);
+size_t List_cache_trim(void);
+
+void List_stats(ListStats *stats);
+void List_stats_reset(void);
 
 #endif
@@ -0,0 +1,297 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include <pthread.h>
+#include <unistd.h>
+
+#include "alloc.h"
+#include "parallel.h"
+
+/*
+ * Ranges a thread still owns, lo in the low half and hi in the
+ * high half, so taking from the front and stealing from the back
+ * are each one compare and swap
+ */
+typedef struct {
+    _Atomic uint64_t bounds;
+    char pad[56];
+} ParallelQueue;
+
+typedef struct {
+    List *list;
+    Node **starts;
+    size_t *lengths;
+    void **partials;
+    size_t ranges;
+    ParallelQueue queues[PARALLEL_MAX];
+    int workers;
+    Apply apply;
+    void *arg;
+    Reduce reduce;
+    void *init;
+} ParallelJob;
+
+/*
+ * Built-in pool, grown on demand and kept for later calls,
+ * which it serves one at a time
+ */
+static struct {
+    pthread_mutex_t call;
+    pthread_mutex_t lock;
+    pthread_cond_t wake;
+    pthread_cond_t done;
+    int threads;
+    size_t generation;
+    int workers;
+    int active;
+    ParallelJob *job;
+} Parallel = {
+    PTHREAD_MUTEX_INITIALIZER, PTHREAD_MUTEX_INITIALIZER,
+    PTHREAD_COND_INITIALIZER, PTHREAD_COND_INITIALIZER, 0, 0, 0, 0, NULL
+};
+
+/*
+ * Internal helper functions
+ */
+static int Parallel_threads(int threads, size_t size);
+static void *Parallel_worker(void *arg);
+static int Parallel_take(ParallelQueue *queue, size_t *range);
+static int Parallel_steal(ParallelQueue *queue, size_t *range);
+static void Parallel_range(ParallelJob *job, size_t range);
+static void Parallel_work(ParallelJob *job, int worker);
+static int Parallel_spawn(int threads);
+static void Parallel_run(ParallelJob *job, int threads);
+
+/*
+ * Threads worth using, all cores when threads <= 0
+ */
+static int Parallel_threads(int threads, size_t size) {
+    if (threads <= 0) {
+        threads = (int) sysconf(_SC_NPROCESSORS_ONLN);
+    }
+    if (threads > PARALLEL_MAX) {
+        threads = PARALLEL_MAX;
+    }
+    if ((size_t) threads > size) {
+        threads = (int) size;
+    }
+    return threads < 1 ? 1 : threads;
+}
+
+/*
+ * Pool thread: sleep until a job needs it, work, report done
+ */
+static void *Parallel_worker(void *arg) {
+    int worker = (int) (size_t) arg;
+    size_t generation = 0;
+
+    pthread_mutex_lock(&Parallel.lock);
+    for (;;) {
+        while (Parallel.generation == generation) {
+            pthread_cond_wait(&Parallel.wake, &Parallel.lock);
+        }
+        generation = Parallel.generation;
+        if (worker >= Parallel.workers) {
+            continue;
+        }
+        ParallelJob *job = Parallel.job;
+        pthread_mutex_unlock(&Parallel.lock);
+
+        Parallel_work(job, worker);
+
+        pthread_mutex_lock(&Parallel.lock);
+        if (--Parallel.active == 0) {
+            pthread_cond_signal(&Parallel.done);
+        }
+    }
+    return NULL;
+}
+
+/*
+ * Take the first range a thread owns
+ */
+static int Parallel_take(ParallelQueue *queue, size_t *range) {
+    uint64_t bounds = atomic_load(&queue->bounds);
+    while ((uint32_t) bounds < bounds >> 32) {
+        if (atomic_compare_exchange_weak(&queue->bounds, &bounds, bounds + 1)) {
+            *range = (uint32_t) bounds;
+            return 1;
+        }
+    }
+    return 0;
+}
+
+/*
+ * Steal the last range another thread owns
+ */
+static int Parallel_steal(ParallelQueue *queue, size_t *range) {
+    uint64_t bounds = atomic_load(&queue->bounds);
+    while ((uint32_t) bounds < bounds >> 32) {
+        uint64_t stolen = bounds - ((uint64_t) 1 << 32);
+        if (atomic_compare_exchange_weak(&queue->bounds, &bounds, stolen)) {
+            *range = stolen >> 32;
+            return 1;
+        }
+    }
+    return 0;
+}
+
+/*
+ * Apply or fold every Node of a range, in view order
+ */
+static void Parallel_range(ParallelJob *job, size_t range) {
+    List *list = job->list;
+    Node *node = job->starts[range];
+    size_t length = job->lengths[range];
+
+    if (job->reduce) {
+        void *acc = job->init;
+        for (size_t i = 0; i < length; i++, node = List_next(list, node)) {
+            acc = job->reduce(acc, node->data);
+        }
+        job->partials[range] = acc;
+    } else {
+        for (size_t i = 0; i < length; i++, node = List_next(list, node)) {
+            job->apply(node->data, job->arg);
+        }
+    }
+}
+
+/*
+ * Work through own ranges, then steal from the other threads
+ * until every range is taken
+ */
+static void Parallel_work(ParallelJob *job, int worker) {
+    size_t range;
+    while (Parallel_take(&job->queues[worker], &range)) {
+        Parallel_range(job, range);
+    }
+    for (int i = 1; i < job->workers; i++) {
+        ParallelQueue *victim = &job->queues[(worker + i) % job->workers];
+        while (Parallel_steal(victim, &range)) {
+            Parallel_range(job, range);
+        }
+    }
+}
+
+/*
+ * Grow the pool to threads - 1 pool threads and return how many
+ * threads a call can use, fewer when a pool thread fails to start
+ */
+static int Parallel_spawn(int threads) {
+    pthread_mutex_lock(&Parallel.lock);
+    for (; Parallel.threads < threads - 1; Parallel.threads++) {
+        pthread_t thread;
+        if (pthread_create(&thread, NULL, Parallel_worker, (void *) (size_t) (Parallel.threads + 1))) {
+            break;
+        }
+        pthread_detach(thread);
+    }
+    if (threads > Parallel.threads + 1) {
+        threads = Parallel.threads + 1;
+    }
+    pthread_mutex_unlock(&Parallel.lock);
+    return threads;
+}
+
+/*
+ * Split the List into ranges, deal them out and work on them with
+ * the calling thread and threads - 1 pool threads, or the ones that
+ * started. Runs on the calling thread alone when another call holds
+ * the pool, as from inside a callback
+ */
+static void Parallel_run(ParallelJob *job, int threads) {
+    List *list = job->list;
+    threads = Parallel_threads(threads, list->size);
+    if (threads > 1 && pthread_mutex_trylock(&Parallel.call)) {
+        threads = 1;
+    } else if (threads > 1) {
+        threads = Parallel_spawn(threads);
+        if (threads == 1) {
+            pthread_mutex_unlock(&Parallel.call);
+        }
+    }
+
+    size_t ranges = (size_t) threads * PARALLEL_SPLIT;
+    ranges = ranges > list->size ? list->size : ranges;
+    job->ranges = ranges;
+    job->starts = LIST_MALLOC(ranges * sizeof(Node *));
+    job->lengths = LIST_MALLOC(ranges * sizeof(size_t));
+    job->partials = LIST_MALLOC(ranges * sizeof(void *));
+
+    Node *node = List_first(list);
+    for (size_t range = 0; range < ranges; range++) {
+        job->starts[range] = node;
+        job->lengths[range] = list->size / ranges + (range < list->size % ranges);
+        for (size_t i = 0; i < job->lengths[range]; i++) {
+            node = List_next(list, node);
+        }
+    }
+
+    job->workers = threads;
+    for (int worker = 0; worker < threads; worker++) {
+        uint64_t lo = ranges * worker / threads;
+        uint64_t hi = ranges * (worker + 1) / threads;
+        atomic_init(&job->queues[worker].bounds, lo | hi << 32);
+    }
+
+    if (threads == 1) {
+        Parallel_work(job, 0);
+        return;
+    }
+
+    pthread_mutex_lock(&Parallel.lock);
+    Parallel.job = job;
+    Parallel.workers = threads;
+    Parallel.active = threads - 1;
+    Parallel.generation++;
+    pthread_cond_broadcast(&Parallel.wake);
+    pthread_mutex_unlock(&Parallel.lock);
+
+    Parallel_work(job, 0);
+
+    pthread_mutex_lock(&Parallel.lock);
+    while (Parallel.active) {
+        pthread_cond_wait(&Parallel.done, &Parallel.lock);
+    }
+    pthread_mutex_unlock(&Parallel.lock);
+    pthread_mutex_unlock(&Parallel.call);
+}
+
+/*
+ * Call apply on every element, from up to threads threads
+ * at once, all cores when threads <= 0
+ */
+void List_parallel_foreach(List *list, Apply apply, void *arg, int threads) {
+    ParallelJob job = { 0 };
+    job.list = list;
+    job.apply = apply;
+    job.arg = arg;
+
+    Parallel_run(&job, threads);
+    LIST_FREE(job.starts);
+    LIST_FREE(job.lengths);
+    LIST_FREE(job.partials);
+}
+
+/*
+ * Fold every range of elements with reduce, each from init, then
+ * combine the results in List order. reduce and combine must be
+ * associative with init as identity, and init left unchanged
+ */
+void *List_parallel_reduce(List *list, Reduce reduce, Combine combine, void *init, int threads) {
+    ParallelJob job = { 0 };
+    job.list = list;
+    job.reduce = reduce;
+    job.init = init;
+
+    Parallel_run(&job, threads);
+    void *acc = init;
+    for (size_t range = 0; range < job.ranges; range++) {
+        acc = combine(acc, job.partials[range]);
+    }
+
+    LIST_FREE(job.starts);
+    LIST_FREE(job.lengths);
+    LIST_FREE(job.partials);
+    return acc;
+}
@@ -0,0 +1,24 @@
+#ifndef PARALLEL_H
+#define PARALLEL_H
+
+#include <stdatomic.h>
+#include <stdint.h>
+
+#include "list.h"
+
+/*
+ * Parallel List traversal: the List is cut into ranges of equal
+ * length in one pass, each thread of a built-in pool starts on its
+ * own share of them and steals from the others when it runs out.
+ * Callbacks must leave the List unchanged
+ */
+#define PARALLEL_MAX 64
+#define PARALLEL_SPLIT 8
+
+typedef void *(*Reduce)(void *acc, void *data);
+typedef void *(*Combine)(void *a, void *b);
+
+void List_parallel_foreach(List *list, Apply apply, void *arg, int threads);
+void *List_parallel_reduce(List *list, Reduce reduce, Combine combine, void *init, int threads);
+
+#endif
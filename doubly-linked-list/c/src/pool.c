@@ -0,0 +1,226 @@
+#include <stdint.h>
+#include <string.h>
+
+#include "alloc.h"
+#include "pool.h"
+
+/*
+ * Chunk and how many of its objects are free, used by Pool_trim
+ */
+typedef struct {
+    uintptr_t start;
+    Chunk *chunk;
+    size_t free;
+} PoolSpan;
+
+/*
+ * Internal helper functions
+ */
+static Chunk *Pool_chunk_new(Pool *pool, size_t count);
+static int Pool_span_compare(const void *a, const void *b);
+static PoolSpan *Pool_span(PoolSpan *spans, size_t count, void *object);
+
+/*
+ * Creates a new Pool of objects with given size, allocated
+ * in chunks of count objects
+ */
+Pool *Pool_new(size_t size, size_t count) {
+    Pool *pool = LIST_CALLOC(1, sizeof(Pool));
+    size_t align = sizeof(Slot);
+    pool->size = (size < align ? align : size + (align - 1)) / align * align;
+    pool->count = count ? count : 1;
+    pool->refs = 1;
+    return pool;
+}
+
+/*
+ * Take a reference to Pool
+ */
+Pool *Pool_retain(Pool *pool) {
+    pool->refs++;
+    return pool;
+}
+
+/*
+ * Drop a reference to Pool, freeing all chunks on the last one
+ */
+void Pool_free(Pool *pool) {
+    if (--pool->refs == 0) {
+        Pool_clear(pool);
+        LIST_FREE(pool);
+    }
+}
+
+/*
+ * Creates a new Chunk of count objects
+ */
+static Chunk *Pool_chunk_new(Pool *pool, size_t count) {
+    Chunk *chunk = LIST_MALLOC(sizeof(Chunk) + pool->size * count);
+    chunk->next = NULL;
+    chunk->count = count;
+    chunk->used = 0;
+    chunk->slots = (char *) (chunk + 1);
+    return chunk;
+}
+
+/*
+ * Allocate a zeroed object from Pool
+ */
+void *Pool_alloc(Pool *pool) {
+    void *object;
+
+    if (pool->free) {
+        object = pool->free;
+        pool->free = pool->free->next;
+    } else {
+        Chunk *chunk = pool->chunks;
+        if (!chunk || chunk->used == chunk->count) {
+            chunk = Pool_chunk_new(pool, pool->count);
+            chunk->next = pool->chunks;
+            pool->chunks = chunk;
+        }
+        object = chunk->slots + chunk->used * pool->size;
+        chunk->used++;
+    }
+
+    pool->used++;
+    return memset(object, 0, pool->size);
+}
+
+/*
+ * Allocate count zeroed objects laid out one after the other in a
+ * chunk of their own, behind the chunk Pool_alloc is filling
+ */
+void *Pool_alloc_many(Pool *pool, size_t count) {
+    Chunk *chunk = Pool_chunk_new(pool, count);
+    chunk->used = count;
+    if (pool->chunks) {
+        chunk->next = pool->chunks->next;
+        pool->chunks->next = chunk;
+    } else {
+        pool->chunks = chunk;
+    }
+
+    pool->used += count;
+    return memset(chunk->slots, 0, pool->size * count);
+}
+
+/*
+ * Release an object back to Pool
+ */
+void Pool_release(Pool *pool, void *object) {
+    Slot *slot = object;
+    slot->next = pool->free;
+    pool->free = slot;
+    pool->used--;
+}
+
+/*
+ * Release all Pool objects and chunks at once
+ */
+void Pool_clear(Pool *pool) {
+    Chunk *chunk = pool->chunks;
+    while (chunk) {
+        Chunk *next = chunk->next;
+        LIST_FREE(chunk);
+        chunk = next;
+    }
+    pool->chunks = NULL;
+    pool->free = NULL;
+    pool->used = 0;
+}
+
+/*
+ * Order spans by address
+ */
+static int Pool_span_compare(const void *a, const void *b) {
+    uintptr_t x = ((const PoolSpan *) a)->start;
+    uintptr_t y = ((const PoolSpan *) b)->start;
+    return x < y ? -1 : x > y;
+}
+
+/*
+ * Find the span holding object, by binary search
+ */
+static PoolSpan *Pool_span(PoolSpan *spans, size_t count, void *object) {
+    uintptr_t address = (uintptr_t) object;
+    size_t lo = 0;
+    size_t hi = count;
+    while (hi - lo > 1) {
+        size_t mid = lo + (hi - lo) / 2;
+        if (spans[mid].start <= address) {
+            lo = mid;
+        } else {
+            hi = mid;
+        }
+    }
+    return &spans[lo];
+}
+
+/*
+ * Free chunks none of whose objects are in use, dropping their
+ * objects from the free list, and return how many were freed.
+ * The free list is walked once, so each free object costs one
+ * memory access plus a search among O(chunks) spans
+ */
+size_t Pool_trim(Pool *pool) {
+    size_t count = 0;
+    size_t handed = 0;
+    for (Chunk *chunk = pool->chunks; chunk; chunk = chunk->next) {
+        count++;
+        handed += chunk->used;
+    }
+    size_t released = handed - pool->used;
+    if (!count) {
+        return 0;
+    }
+
+    PoolSpan *spans = LIST_MALLOC(count * sizeof(PoolSpan));
+    Slot **slots = LIST_MALLOC((released ? released : 1) * sizeof(Slot *));
+    size_t i = 0;
+    for (Chunk *chunk = pool->chunks; chunk; chunk = chunk->next, i++) {
+        spans[i].start = (uintptr_t) chunk->slots;
+        spans[i].chunk = chunk;
+        spans[i].free = 0;
+    }
+    qsort(spans, count, sizeof(PoolSpan), Pool_span_compare);
+
+    i = 0;
+    for (Slot *slot = pool->free; slot; slot = slot->next) {
+        slots[i++] = slot;
+        Pool_span(spans, count, slot)->free++;
+    }
+
+    Slot **link = &pool->free;
+    for (i = 0; i < released; i++) {
+        PoolSpan *span = Pool_span(spans, count, slots[i]);
+        if (span->free != span->chunk->used) {
+            *link = slots[i];
+            link = &slots[i]->next;
+        }
+    }
+    *link = NULL;
+
+    for (i = 0; i < count; i++) {
+        if (spans[i].free == spans[i].chunk->used) {
+            spans[i].chunk->count = 0;
+        }
+    }
+
+    size_t freed = 0;
+    Chunk **chunk = &pool->chunks;
+    while (*chunk) {
+        if (!(*chunk)->count) {
+            Chunk *next = (*chunk)->next;
+            LIST_FREE(*chunk);
+            *chunk = next;
+            freed++;
+        } else {
+            chunk = &(*chunk)->next;
+        }
+    }
+
+    LIST_FREE(slots);
+    LIST_FREE(spans);
+    return freed;
+}
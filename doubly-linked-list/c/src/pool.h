@@ -0,0 +1,40 @@
+#ifndef POOL_H
+#define POOL_H
+
+#include <stdlib.h>
+
+typedef struct Pool Pool;
+typedef struct Chunk Chunk;
+typedef struct Slot Slot;
+
+struct Slot {
+    Slot *next;
+};
+
+struct Chunk {
+    Chunk *next;
+    size_t count;
+    size_t used;
+    char *slots;
+};
+
+struct Pool {
+    Chunk *chunks;
+    Slot *free;
+    size_t size;
+    size_t count;
+    size_t used;
+    size_t refs;
+};
+
+Pool *Pool_new(size_t size, size_t count);
+Pool *Pool_retain(Pool *pool);
+void Pool_free(Pool *pool);
+
+void *Pool_alloc(Pool *pool);
+void *Pool_alloc_many(Pool *pool, size_t count);
+void Pool_release(Pool *pool, void *object);
+void Pool_clear(Pool *pool);
+size_t Pool_trim(Pool *pool);
+
+#endif
@@ -0,0 +1,387 @@
+#include <stdint.h>
+
+#include "alloc.h"
+#include "rank.h"
+
+/*
+ * Internal helper functions
+ */
+static size_t Rank_count(Rank *rank);
+static void Rank_update(Rank *rank);
+static void Rank_rotate_up(Rank **root, Rank *rank);
+static void Rank_attach(Rank **root, Rank *parent, Rank **link, Rank *rank);
+static size_t Rank_recount(Rank *rank);
+static uint64_t Rank_mix(uint64_t hash);
+static size_t RankMap_home(RankMap *map, void *item);
+static void RankMap_grow(RankMap *map);
+
+#define RANK_MAP_MIN 16
+
+/*
+ * Creates a new Rank, with a priority mixed from its address
+ */
+Rank *Rank_new(void *item) {
+    Rank *rank = LIST_CALLOC(1, sizeof(Rank));
+    rank->priority = Rank_mix((uintptr_t) rank);
+    rank->item = item;
+    rank->count = 1;
+    return rank;
+}
+
+/*
+ * Scramble the bits of hash (splitmix64 finalizer)
+ */
+static uint64_t Rank_mix(uint64_t hash) {
+    hash = (hash ^ (hash >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    hash = (hash ^ (hash >> 27)) * 0x94d049bb133111ebULL;
+    return hash ^ (hash >> 31);
+}
+
+/*
+ * Free Rank allocated memory
+ */
+void Rank_free(Rank *rank) {
+    LIST_FREE(rank);
+}
+
+/*
+ * Subtree size, zero for empty trees
+ */
+static size_t Rank_count(Rank *rank) {
+    return rank ? rank->count : 0;
+}
+
+/*
+ * Recompute subtree size from children
+ */
+static void Rank_update(Rank *rank) {
+    rank->count = 1 + Rank_count(rank->left) + Rank_count(rank->right);
+}
+
+/*
+ * Get Rank position inside its tree
+ */
+size_t Rank_index(Rank *rank) {
+    size_t index = Rank_count(rank->left);
+    for (; rank->parent; rank = rank->parent) {
+        if (rank == rank->parent->right) {
+            index += Rank_count(rank->parent->left) + 1;
+        }
+    }
+    return index;
+}
+
+/*
+ * Get Rank tree root
+ */
+Rank *Rank_root(Rank *rank) {
+    while (rank->parent) {
+        rank = rank->parent;
+    }
+    return rank;
+}
+
+/*
+ * Get Rank at index
+ */
+Rank *Rank_select(Rank *root, size_t index) {
+    Rank *rank = root;
+    while (rank) {
+        size_t left = Rank_count(rank->left);
+        if (index < left) {
+            rank = rank->left;
+        } else if (index == left) {
+            return rank;
+        } else {
+            index -= left + 1;
+            rank = rank->right;
+        }
+    }
+    return NULL;
+}
+
+/*
+ * Rotate Rank above its parent
+ */
+static void Rank_rotate_up(Rank **root, Rank *rank) {
+    Rank *parent = rank->parent;
+    Rank *grand = parent->parent;
+
+    if (parent->left == rank) {
+        parent->left = rank->right;
+        if (rank->right) {
+            rank->right->parent = parent;
+        }
+        rank->right = parent;
+    } else {
+        parent->right = rank->left;
+        if (rank->left) {
+            rank->left->parent = parent;
+        }
+        rank->left = parent;
+    }
+
+    parent->parent = rank;
+    rank->parent = grand;
+    if (!grand) {
+        *root = rank;
+    } else if (grand->left == parent) {
+        grand->left = rank;
+    } else {
+        grand->right = rank;
+    }
+
+    Rank_update(parent);
+    Rank_update(rank);
+}
+
+/*
+ * Attach Rank as a leaf, then restore the heap order
+ */
+static void Rank_attach(Rank **root, Rank *parent, Rank **link, Rank *rank) {
+    rank->parent = parent;
+    rank->left = NULL;
+    rank->right = NULL;
+    rank->count = 1;
+    *link = rank;
+
+    for (Rank *current = parent; current; current = current->parent) {
+        current->count++;
+    }
+    while (rank->parent && rank->priority > rank->parent->priority) {
+        Rank_rotate_up(root, rank);
+    }
+}
+
+/*
+ * Insert Rank right before ref, or as the only Rank if ref is NULL
+ */
+void Rank_insert_before(Rank **root, Rank *ref, Rank *rank) {
+    if (!ref) {
+        Rank_attach(root, NULL, root, rank);
+    } else if (!ref->left) {
+        Rank_attach(root, ref, &ref->left, rank);
+    } else {
+        Rank *current = ref->left;
+        while (current->right) {
+            current = current->right;
+        }
+        Rank_attach(root, current, &current->right, rank);
+    }
+}
+
+/*
+ * Insert Rank right after ref, or as the only Rank if ref is NULL
+ */
+void Rank_insert_after(Rank **root, Rank *ref, Rank *rank) {
+    if (!ref) {
+        Rank_attach(root, NULL, root, rank);
+    } else if (!ref->right) {
+        Rank_attach(root, ref, &ref->right, rank);
+    } else {
+        Rank *current = ref->right;
+        while (current->left) {
+            current = current->left;
+        }
+        Rank_attach(root, current, &current->left, rank);
+    }
+}
+
+/*
+ * Remove Rank from its tree, rotating it down to a leaf first
+ */
+void Rank_remove(Rank **root, Rank *rank) {
+    while (rank->left && rank->right) {
+        if (rank->left->priority > rank->right->priority) {
+            Rank_rotate_up(root, rank->left);
+        } else {
+            Rank_rotate_up(root, rank->right);
+        }
+    }
+
+    Rank *child = rank->left ? rank->left : rank->right;
+    Rank *parent = rank->parent;
+    if (child) {
+        child->parent = parent;
+    }
+    if (!parent) {
+        *root = child;
+    } else if (parent->left == rank) {
+        parent->left = child;
+    } else {
+        parent->right = child;
+    }
+
+    for (; parent; parent = parent->parent) {
+        parent->count--;
+    }
+    rank->parent = NULL;
+    rank->left = NULL;
+    rank->right = NULL;
+    rank->count = 1;
+}
+
+/*
+ * Append Rank to a tree under construction, given its last Rank,
+ * keeping the right spine ordered by priority
+ */
+void Rank_append(Rank **last, Rank *rank) {
+    Rank *top = *last;
+    Rank *popped = NULL;
+    while (top && top->priority < rank->priority) {
+        popped = top;
+        top = top->parent;
+    }
+
+    rank->left = popped;
+    rank->right = NULL;
+    if (popped) {
+        popped->parent = rank;
+    }
+    rank->parent = top;
+    if (top) {
+        top->right = rank;
+    }
+    *last = rank;
+}
+
+/*
+ * Recompute subtree sizes below Rank
+ */
+static size_t Rank_recount(Rank *rank) {
+    if (!rank) {
+        return 0;
+    }
+    rank->count = 1 + Rank_recount(rank->left) + Rank_recount(rank->right);
+    return rank->count;
+}
+
+/*
+ * Finish a tree built by appending, returning its root
+ */
+Rank *Rank_build(Rank *last) {
+    if (!last) {
+        return NULL;
+    }
+    Rank *root = Rank_root(last);
+    Rank_recount(root);
+    return root;
+}
+
+/*
+ * Creates a new empty RankMap
+ */
+RankMap *RankMap_new(void) {
+    RankMap *map = LIST_MALLOC(sizeof(RankMap));
+    map->slots = LIST_CALLOC(RANK_MAP_MIN, sizeof(Rank *));
+    map->mask = RANK_MAP_MIN - 1;
+    map->count = 0;
+    return map;
+}
+
+/*
+ * Free RankMap allocated memory, not the Ranks it holds
+ */
+void RankMap_free(RankMap *map) {
+    LIST_FREE(map->slots);
+    LIST_FREE(map);
+}
+
+/*
+ * Forget every Rank, shrinking back to the initial size
+ */
+void RankMap_clear(RankMap *map) {
+    LIST_FREE(map->slots);
+    map->slots = LIST_CALLOC(RANK_MAP_MIN, sizeof(Rank *));
+    map->mask = RANK_MAP_MIN - 1;
+    map->count = 0;
+}
+
+/*
+ * Slot where the search for item starts
+ */
+static size_t RankMap_home(RankMap *map, void *item) {
+    return Rank_mix((uintptr_t) item) & map->mask;
+}
+
+/*
+ * Double the table, keeping it at most half full
+ */
+static void RankMap_grow(RankMap *map) {
+    Rank **slots = map->slots;
+    size_t capacity = map->mask + 1;
+    map->slots = LIST_CALLOC(capacity * 2, sizeof(Rank *));
+    map->mask = capacity * 2 - 1;
+    for (size_t i = 0; i < capacity; i++) {
+        if (slots[i]) {
+            size_t slot = RankMap_home(map, slots[i]->item);
+            while (map->slots[slot]) {
+                slot = (slot + 1) & map->mask;
+            }
+            map->slots[slot] = slots[i];
+        }
+    }
+    LIST_FREE(slots);
+}
+
+/*
+ * Add Rank, keyed by its item, replacing any Rank of that item
+ */
+void RankMap_put(RankMap *map, Rank *rank) {
+    if ((map->count + 1) * 2 > map->mask + 1) {
+        RankMap_grow(map);
+    }
+    size_t slot = RankMap_home(map, rank->item);
+    while (map->slots[slot] && map->slots[slot]->item != rank->item) {
+        slot = (slot + 1) & map->mask;
+    }
+    if (!map->slots[slot]) {
+        map->count++;
+    }
+    map->slots[slot] = rank;
+}
+
+/*
+ * Get the Rank of item, NULL if none
+ */
+Rank *RankMap_get(RankMap *map, void *item) {
+    size_t slot = RankMap_home(map, item);
+    while (map->slots[slot]) {
+        if (map->slots[slot]->item == item) {
+            return map->slots[slot];
+        }
+        slot = (slot + 1) & map->mask;
+    }
+    return NULL;
+}
+
+/*
+ * Remove and return the Rank of item, NULL if none. Later entries
+ * of the probe run shift back, so lookups need no tombstones
+ */
+Rank *RankMap_remove(RankMap *map, void *item) {
+    size_t hole = RankMap_home(map, item);
+    while (map->slots[hole] && map->slots[hole]->item != item) {
+        hole = (hole + 1) & map->mask;
+    }
+    Rank *rank = map->slots[hole];
+    if (!rank) {
+        return NULL;
+    }
+
+    size_t slot = hole;
+    for (;;) {
+        slot = (slot + 1) & map->mask;
+        if (!map->slots[slot]) {
+            break;
+        }
+        size_t home = RankMap_home(map, map->slots[slot]->item);
+        if (((slot - home) & map->mask) >= ((slot - hole) & map->mask)) {
+            map->slots[hole] = map->slots[slot];
+            hole = slot;
+        }
+    }
+    map->slots[hole] = NULL;
+    map->count--;
+    return rank;
+}
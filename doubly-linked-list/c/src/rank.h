@@ -0,0 +1,53 @@
+#ifndef RANK_H
+#define RANK_H
+
+#include <stdlib.h>
+
+/*
+ * Order statistic tree: an implicit treap where each Rank knows
+ * the size of its subtree, so positions are found in O(log n)
+ */
+typedef struct Rank Rank;
+typedef struct RankMap RankMap;
+
+struct Rank {
+    void *item;
+    Rank *parent;
+    Rank *left;
+    Rank *right;
+    size_t count;
+    size_t priority;
+};
+
+/*
+ * Open addressing table finding the Rank of an item, so items
+ * need not point back to their Rank
+ */
+struct RankMap {
+    Rank **slots;
+    size_t mask;
+    size_t count;
+};
+
+Rank *Rank_new(void *item);
+void Rank_free(Rank *rank);
+
+size_t Rank_index(Rank *rank);
+Rank *Rank_root(Rank *rank);
+Rank *Rank_select(Rank *root, size_t index);
+
+void Rank_insert_before(Rank **root, Rank *ref, Rank *rank);
+void Rank_insert_after(Rank **root, Rank *ref, Rank *rank);
+void Rank_remove(Rank **root, Rank *rank);
+
+void Rank_append(Rank **last, Rank *rank);
+Rank *Rank_build(Rank *last);
+
+RankMap *RankMap_new(void);
+void RankMap_free(RankMap *map);
+void RankMap_clear(RankMap *map);
+void RankMap_put(RankMap *map, Rank *rank);
+Rank *RankMap_get(RankMap *map, void *item);
+Rank *RankMap_remove(RankMap *map, void *item);
+
+#endif
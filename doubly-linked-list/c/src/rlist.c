@@ -0,0 +1,230 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include <sched.h>
+
+#include "alloc.h"
+#include "rlist.h"
+
+/*
+ * Internal helper functions
+ */
+static RNode *RList_node_new(void *data);
+static void RList_node_free(void *node);
+static void RList_retire(RList *list, RNode *node);
+static void RList_link(RList *list, RNode *prev, RNode *node, RNode *next);
+
+/*
+ * Creates a new RList
+ */
+RList *RList_new(Free free) {
+    RList *list = LIST_CALLOC(1, sizeof(RList));
+    atomic_init(&list->head, NULL);
+    pthread_mutex_init(&list->lock, NULL);
+    list->epoch = Epoch_new();
+    list->writer = Epoch_register(list->epoch);
+    list->free = free;
+    return list;
+}
+
+/*
+ * Free RList allocated memory, no reader may still be inside
+ */
+void RList_free(RList *list) {
+    RNode *node = atomic_load(&list->head);
+    while (node) {
+        RNode *next = atomic_load(&node->next);
+        if (list->free) {
+            list->free(node->data);
+        }
+        LIST_FREE(node);
+        node = next;
+    }
+    Epoch_free(list->epoch);
+    pthread_mutex_destroy(&list->lock);
+    LIST_FREE(list);
+}
+
+/*
+ * Get a per thread reader handle
+ */
+EpochThread *RList_register(RList *list) {
+    return Epoch_register(list->epoch);
+}
+
+/*
+ * Give up a per thread reader handle
+ */
+void RList_unregister(EpochThread *thread) {
+    Epoch_unregister(thread);
+}
+
+/*
+ * Start reading, RNodes seen stay valid until RList_read_unlock
+ */
+void RList_read_lock(EpochThread *thread) {
+    Epoch_enter(thread);
+}
+
+/*
+ * Stop reading
+ */
+void RList_read_unlock(EpochThread *thread) {
+    Epoch_exit(thread);
+}
+
+/*
+ * Get first RNode, NULL when empty. Readers only
+ */
+RNode *RList_first(RList *list) {
+    return atomic_load_explicit(&list->head, memory_order_acquire);
+}
+
+/*
+ * Get next RNode, NULL at the end. Readers only
+ */
+RNode *RList_next(RNode *node) {
+    return atomic_load_explicit(&node->next, memory_order_acquire);
+}
+
+/*
+ * Creates a new RNode
+ */
+static RNode *RList_node_new(void *data) {
+    RNode *node = LIST_CALLOC(1, sizeof(RNode));
+    node->data = data;
+    atomic_init(&node->next, NULL);
+    return node;
+}
+
+/*
+ * Free a retired RNode, its element has its own retirement
+ */
+static void RList_node_free(void *node) {
+    LIST_FREE(node);
+}
+
+/*
+ * Defer freeing RNode and its element past a grace period
+ */
+static void RList_retire(RList *list, RNode *node) {
+    if (list->free) {
+        Epoch_retire(list->writer, node->data, list->free);
+    }
+    Epoch_retire(list->writer, node, RList_node_free);
+}
+
+/*
+ * Link an initialized RNode between prev and next, making it
+ * visible to readers with one release store
+ */
+static void RList_link(RList *list, RNode *prev, RNode *node, RNode *next) {
+    node->prev = prev;
+    atomic_store_explicit(&node->next, next, memory_order_relaxed);
+    if (next) {
+        next->prev = node;
+    } else {
+        list->tail = node;
+    }
+    if (prev) {
+        atomic_store_explicit(&prev->next, node, memory_order_release);
+    } else {
+        atomic_store_explicit(&list->head, node, memory_order_release);
+    }
+    list->size++;
+}
+
+/*
+ * Add element to RList head
+ */
+RNode *RList_add_head(RList *list, void *data) {
+    RNode *node = RList_node_new(data);
+    pthread_mutex_lock(&list->lock);
+    RList_link(list, NULL, node, atomic_load_explicit(&list->head, memory_order_relaxed));
+    pthread_mutex_unlock(&list->lock);
+    return node;
+}
+
+/*
+ * Add element to RList tail
+ */
+RNode *RList_add_tail(RList *list, void *data) {
+    RNode *node = RList_node_new(data);
+    pthread_mutex_lock(&list->lock);
+    RList_link(list, list->tail, node, NULL);
+    pthread_mutex_unlock(&list->lock);
+    return node;
+}
+
+/*
+ * Add element before ref
+ */
+RNode *RList_add_before(RList *list, RNode *ref, void *data) {
+    RNode *node = RList_node_new(data);
+    pthread_mutex_lock(&list->lock);
+    RList_link(list, ref->prev, node, ref);
+    pthread_mutex_unlock(&list->lock);
+    return node;
+}
+
+/*
+ * Add element after ref
+ */
+RNode *RList_add_after(RList *list, RNode *ref, void *data) {
+    RNode *node = RList_node_new(data);
+    pthread_mutex_lock(&list->lock);
+    RList_link(list, ref, node, atomic_load_explicit(&ref->next, memory_order_relaxed));
+    pthread_mutex_unlock(&list->lock);
+    return node;
+}
+
+/*
+ * Replace RNode with a copy holding data, readers see either
+ * the old or the new one, and the old one is retired
+ */
+RNode *RList_replace(RList *list, RNode *node, void *data) {
+    RNode *copy = RList_node_new(data);
+    pthread_mutex_lock(&list->lock);
+    RNode *next = atomic_load_explicit(&node->next, memory_order_relaxed);
+    list->size--;
+    RList_link(list, node->prev, copy, next);
+    RList_retire(list, node);
+    pthread_mutex_unlock(&list->lock);
+    return copy;
+}
+
+/*
+ * Delete RNode from RList. Readers standing on it can still
+ * move on, its memory and element are freed after a grace period
+ */
+void RList_delete(RList *list, RNode *node) {
+    pthread_mutex_lock(&list->lock);
+    RNode *next = atomic_load_explicit(&node->next, memory_order_relaxed);
+    if (node->prev) {
+        atomic_store_explicit(&node->prev->next, next, memory_order_release);
+    } else {
+        atomic_store_explicit(&list->head, next, memory_order_release);
+    }
+    if (next) {
+        next->prev = node->prev;
+    } else {
+        list->tail = node->prev;
+    }
+    list->size--;
+    RList_retire(list, node);
+    pthread_mutex_unlock(&list->lock);
+}
+
+/*
+ * Wait until everything deleted so far is freed. Must not be
+ * called from inside a read section
+ */
+void RList_synchronize(RList *list) {
+    pthread_mutex_lock(&list->lock);
+    while (list->writer->first < list->writer->count) {
+        Epoch_collect(list->writer);
+        if (list->writer->first < list->writer->count) {
+            sched_yield();
+        }
+    }
+    pthread_mutex_unlock(&list->lock);
+}
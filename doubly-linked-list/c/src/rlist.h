@@ -0,0 +1,57 @@
+#ifndef RLIST_H
+#define RLIST_H
+
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdlib.h>
+
+#include "epoch.h"
+#include "list.h"
+
+/*
+ * Read-copy-update List for read mostly data: writers take one
+ * mutex and publish each change with a single release store,
+ * readers walk next pointers with plain acquire loads inside
+ * RList_read_lock / RList_read_unlock, and removed RNodes are
+ * freed only after every reader that could see them is gone
+ */
+typedef struct RNode RNode;
+typedef struct RList RList;
+
+struct RNode {
+    void *data;
+    _Atomic(RNode *) next;
+    RNode *prev;
+};
+
+struct RList {
+    _Atomic(RNode *) head;
+    RNode *tail;
+    size_t size;
+    pthread_mutex_t lock;
+    Epoch *epoch;
+    EpochThread *writer;
+    Free free;
+};
+
+RList *RList_new(void (*free)(void *data));
+void RList_free(RList *list);
+
+EpochThread *RList_register(RList *list);
+void RList_unregister(EpochThread *thread);
+
+void RList_read_lock(EpochThread *thread);
+void RList_read_unlock(EpochThread *thread);
+RNode *RList_first(RList *list);
+RNode *RList_next(RNode *node);
+
+RNode *RList_add_head(RList *list, void *data);
+RNode *RList_add_tail(RList *list, void *data);
+RNode *RList_add_before(RList *list, RNode *ref, void *data);
+RNode *RList_add_after(RList *list, RNode *ref, void *data);
+RNode *RList_replace(RList *list, RNode *node, void *data);
+
+void RList_delete(RList *list, RNode *node);
+void RList_synchronize(RList *list);
+
+#endif
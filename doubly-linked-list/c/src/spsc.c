@@ -0,0 +1,131 @@
+#include "alloc.h"
+#include "spsc.h"
+
+/*
+ * Internal helper functions
+ */
+static size_t Spsc_room(Spsc *queue, size_t tail, size_t count);
+static size_t Spsc_ready(Spsc *queue, size_t head, size_t count);
+
+/*
+ * Creates a new Spsc queue holding up to capacity elements,
+ * its Nodes linked in a ring
+ */
+Spsc *Spsc_new(size_t capacity, Free free) {
+    Spsc *queue = LIST_CALLOC(1, sizeof(Spsc));
+    queue->capacity = capacity ? capacity : 1;
+    queue->nodes = LIST_CALLOC(queue->capacity, sizeof(Node));
+    for (size_t i = 0; i < queue->capacity; i++) {
+        queue->nodes[i].next = &queue->nodes[(i + 1) % queue->capacity];
+        queue->nodes[i].prev = &queue->nodes[(i + queue->capacity - 1) % queue->capacity];
+    }
+    atomic_init(&queue->head, 0);
+    atomic_init(&queue->tail, 0);
+    queue->write = queue->nodes;
+    queue->read = queue->nodes;
+    queue->free = free;
+    return queue;
+}
+
+/*
+ * Free Spsc allocated memory, once both threads are done with it
+ */
+void Spsc_free(Spsc *queue) {
+    if (queue->free) {
+        void *data;
+        while (Spsc_pop(queue, &data)) {
+            queue->free(data);
+        }
+    }
+    LIST_FREE(queue->nodes);
+    LIST_FREE(queue);
+}
+
+/*
+ * Number of queued elements, exact only when both sides are idle
+ */
+size_t Spsc_size(Spsc *queue) {
+    return atomic_load(&queue->tail) - atomic_load(&queue->head);
+}
+
+/*
+ * Free slots for the producer, up to count, reading the
+ * consumer's head only when the cached one shows too few
+ */
+static size_t Spsc_room(Spsc *queue, size_t tail, size_t count) {
+    size_t room = queue->capacity - (tail - queue->head_cache);
+    if (room < count) {
+        queue->head_cache = atomic_load_explicit(&queue->head, memory_order_acquire);
+        room = queue->capacity - (tail - queue->head_cache);
+    }
+    return room < count ? room : count;
+}
+
+/*
+ * Queued elements for the consumer, up to count, reading the
+ * producer's tail only when the cached one shows too few
+ */
+static size_t Spsc_ready(Spsc *queue, size_t head, size_t count) {
+    size_t ready = queue->tail_cache - head;
+    if (ready < count) {
+        queue->tail_cache = atomic_load_explicit(&queue->tail, memory_order_acquire);
+        ready = queue->tail_cache - head;
+    }
+    return ready < count ? ready : count;
+}
+
+/*
+ * Add element to queue tail, 0 if it is full. Producer only
+ */
+int Spsc_push(Spsc *queue, void *data) {
+    return Spsc_push_many(queue, &data, 1) == 1;
+}
+
+/*
+ * Add as many of count elements as fit, publishing them at once,
+ * and return how many were added. Producer only
+ */
+size_t Spsc_push_many(Spsc *queue, void *data[], size_t count) {
+    size_t tail = atomic_load_explicit(&queue->tail, memory_order_relaxed);
+    count = Spsc_room(queue, tail, count);
+
+    Node *node = queue->write;
+    for (size_t i = 0; i < count; i++) {
+        node->data = data[i];
+        node = node->next;
+    }
+    queue->write = node;
+
+    if (count) {
+        atomic_store_explicit(&queue->tail, tail + count, memory_order_release);
+    }
+    return count;
+}
+
+/*
+ * Remove queue head, 0 if it is empty. Consumer only
+ */
+int Spsc_pop(Spsc *queue, void **data) {
+    return Spsc_pop_many(queue, data, 1) == 1;
+}
+
+/*
+ * Remove up to count elements, releasing their Nodes to the
+ * producer at once, and return how many were removed. Consumer only
+ */
+size_t Spsc_pop_many(Spsc *queue, void *data[], size_t count) {
+    size_t head = atomic_load_explicit(&queue->head, memory_order_relaxed);
+    count = Spsc_ready(queue, head, count);
+
+    Node *node = queue->read;
+    for (size_t i = 0; i < count; i++) {
+        data[i] = node->data;
+        node = node->next;
+    }
+    queue->read = node;
+
+    if (count) {
+        atomic_store_explicit(&queue->head, head + count, memory_order_release);
+    }
+    return count;
+}
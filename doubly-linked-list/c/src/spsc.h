@@ -0,0 +1,46 @@
+#ifndef SPSC_H
+#define SPSC_H
+
+#include <stdatomic.h>
+#include <stdlib.h>
+
+#include "list.h"
+
+/*
+ * Wait-free single producer, single consumer queue over a fixed
+ * ring of Nodes: the consumer hands each Node back to the producer
+ * just by moving head past it, so steady state never allocates.
+ * Producer and consumer state sit on separate cache lines, and
+ * each side caches the other's index to touch it only when needed
+ */
+#define SPSC_LINE 64
+
+typedef struct Spsc Spsc;
+
+struct Spsc {
+    atomic_size_t tail;
+    size_t head_cache;
+    Node *write;
+    char producer[SPSC_LINE];
+
+    atomic_size_t head;
+    size_t tail_cache;
+    Node *read;
+    char consumer[SPSC_LINE];
+
+    Node *nodes;
+    size_t capacity;
+    Free free;
+};
+
+Spsc *Spsc_new(size_t capacity, void (*free)(void *data));
+void Spsc_free(Spsc *queue);
+
+size_t Spsc_size(Spsc *queue);
+
+int Spsc_push(Spsc *queue, void *data);
+size_t Spsc_push_many(Spsc *queue, void *data[], size_t count);
+int Spsc_pop(Spsc *queue, void **data);
+size_t Spsc_pop_many(Spsc *queue, void *data[], size_t count);
+
+#endif
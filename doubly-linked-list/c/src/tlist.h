@@ -0,0 +1,287 @@
+#ifndef TLIST_H
+#define TLIST_H
+
+#include <stdlib.h>
+
+#include "alloc.h"
+
+/*
+ * Typed Lists storing values inline in their Nodes:
+ *
+ *     LIST_DEFINE(IntList, int, LIST_TRIVIAL)
+ *
+ * defines IntList, IntListNode and IntList_new, IntList_add_tail
+ * and so on, mirroring the add, lookup, relink and delete functions
+ * of list.h. The destructor is called with a pointer to the value,
+ * LIST_TRIVIAL for types needing none.
+ *
+ * Nodes keep no owner, rank or cursor, so contains and get_index
+ * walk the List. Not generated: the order statistic index, flipped
+ * views, Pools and caches, iterators, bulk, sort, merge, compact,
+ * filter and stats functions
+ */
+#define LIST_TRIVIAL(value) ((void) (value))
+
+#define LIST_DEFINE(name, T, destructor)                                   \
+typedef struct name name;                                                  \
+typedef struct name##Node name##Node;                                      \
+                                                                           \
+struct name##Node {                                                        \
+    name##Node *next;                                                      \
+    name##Node *prev;                                                      \
+    T data;                                                                \
+};                                                                         \
+                                                                           \
+struct name {                                                              \
+    name##Node *head;                                                      \
+    name##Node *tail;                                                      \
+    size_t size;                                                           \
+};                                                                         \
+                                                                           \
+static inline name *name##_new(void) {                                     \
+    return LIST_CALLOC(1, sizeof(name));                                   \
+}                                                                          \
+                                                                           \
+static inline void name##_clear(name *list) {                              \
+    name##Node *node = list->head;                                         \
+    while (node) {                                                         \
+        name##Node *next = node->next;                                     \
+        destructor(&node->data);                                           \
+        LIST_FREE(node);                                                   \
+        node = next;                                                       \
+    }                                                                      \
+    list->head = NULL;                                                     \
+    list->tail = NULL;                                                     \
+    list->size = 0;                                                        \
+}                                                                          \
+                                                                           \
+static inline void name##_free(name *list) {                               \
+    name##_clear(list);                                                    \
+    LIST_FREE(list);                                                       \
+}                                                                          \
+                                                                           \
+static inline int name##_is_empty(name *list) {                            \
+    return list->head ? 0 : 1;                                             \
+}                                                                          \
+                                                                           \
+static inline int name##_has_some(name *list) {                            \
+    return list->head ? 1 : 0;                                             \
+}                                                                          \
+                                                                           \
+static inline name##Node *name##_first(name *list) {                       \
+    return list->head;                                                     \
+}                                                                          \
+                                                                           \
+static inline name##Node *name##_last(name *list) {                        \
+    return list->tail;                                                     \
+}                                                                          \
+                                                                           \
+static inline name##Node *name##_next(name *list, name##Node *node) {      \
+    (void) list;                                                           \
+    return node->next;                                                     \
+}                                                                          \
+                                                                           \
+static inline name##Node *name##_prev(name *list, name##Node *node) {      \
+    (void) list;                                                           \
+    return node->prev;                                                     \
+}                                                                          \
+                                                                           \
+static inline name##Node *name##_get_at(name *list, int index) {           \
+    if (index < 0 || (size_t) index >= list->size) {                       \
+        return NULL;                                                       \
+    }                                                                      \
+    name##Node *node;                                                      \
+    if ((size_t) index < list->size / 2) {                                 \
+        for (node = list->head; index--; node = node->next);               \
+    } else {                                                               \
+        index = list->size - 1 - index;                                    \
+        for (node = list->tail; index--; node = node->prev);               \
+    }                                                                      \
+    return node;                                                           \
+}                                                                          \
+                                                                           \
+static inline int name##_get_index(name *list, name##Node *node) {         \
+    name##Node *current = list->head;                                      \
+    for (int index = 0; current; index++) {                                \
+        if (current == node) {                                             \
+            return index;                                                  \
+        }                                                                  \
+        current = current->next;                                           \
+    }                                                                      \
+    return -1;                                                             \
+}                                                                          \
+                                                                           \
+static inline int name##_contains(name *list, name##Node *node) {          \
+    return node && name##_get_index(list, node) >= 0;                      \
+}                                                                          \
+                                                                           \
+static inline void name##_insert(name *list, name##Node *prev,             \
+                                 name##Node *next, name##Node *node) {     \
+    node->prev = prev;                                                     \
+    node->next = next;                                                     \
+    if (prev) {                                                            \
+        prev->next = node;                                                 \
+    } else {                                                               \
+        list->head = node;                                                 \
+    }                                                                      \
+    if (next) {                                                            \
+        next->prev = node;                                                 \
+    } else {                                                               \
+        list->tail = node;                                                 \
+    }                                                                      \
+    list->size++;                                                          \
+}                                                                          \
+                                                                           \
+static inline void name##_unlink(name *list, name##Node *node) {           \
+    if (node->prev) {                                                      \
+        node->prev->next = node->next;                                     \
+    } else {                                                               \
+        list->head = node->next;                                           \
+    }                                                                      \
+    if (node->next) {                                                      \
+        node->next->prev = node->prev;                                     \
+    } else {                                                               \
+        list->tail = node->prev;                                           \
+    }                                                                      \
+    list->size--;                                                          \
+}                                                                          \
+                                                                           \
+static inline name##Node *name##_link(name *list, name##Node *prev,        \
+                                      name##Node *next, T data) {          \
+    name##Node *node = LIST_MALLOC(sizeof(name##Node));                    \
+    node->data = data;                                                     \
+    name##_insert(list, prev, next, node);                                 \
+    return node;                                                           \
+}                                                                          \
+                                                                           \
+static inline name##Node *name##_add_head(name *list, T data) {            \
+    return name##_link(list, NULL, list->head, data);                      \
+}                                                                          \
+                                                                           \
+static inline name##Node *name##_add_tail(name *list, T data) {            \
+    return name##_link(list, list->tail, NULL, data);                      \
+}                                                                          \
+                                                                           \
+static inline name##Node *name##_add_before(name *list, name##Node *ref,   \
+                                            T data) {                      \
+    return name##_link(list, ref->prev, ref, data);                        \
+}                                                                          \
+                                                                           \
+static inline name##Node *name##_add_after(name *list, name##Node *ref,    \
+                                           T data) {                       \
+    return name##_link(list, ref, ref->next, data);                        \
+}                                                                          \
+                                                                           \
+static inline name##Node *name##_add_at(name *list, int index, T data) {   \
+    name##Node *node = name##_get_at(list, index);                         \
+    return node ? name##_add_before(list, node, data) : NULL;              \
+}                                                                          \
+                                                                           \
+static inline void name##_swap(name *list, name##Node *a, name##Node *b) { \
+    if (a == b) {                                                          \
+        return;                                                            \
+    }                                                                      \
+    if (a->next == b) {                                                    \
+        name##_unlink(list, b);                                            \
+        name##_insert(list, a->prev, a, b);                                \
+    } else if (b->next == a) {                                             \
+        name##_unlink(list, a);                                            \
+        name##_insert(list, b->prev, b, a);                                \
+    } else {                                                               \
+        name##Node *next = a->next;                                        \
+        name##_unlink(list, a);                                            \
+        name##_insert(list, b->prev, b, a);                                \
+        name##_unlink(list, b);                                            \
+        name##_insert(list, next ? next->prev : list->tail, next, b);      \
+    }                                                                      \
+}                                                                          \
+                                                                           \
+static inline void name##_rotate(name *list, int k) {                      \
+    int size = list->size;                                                 \
+    if (size < 2 || (k %= size) == 0) {                                    \
+        return;                                                            \
+    }                                                                      \
+    name##Node *head = name##_get_at(list, k < 0 ? k + size : k);          \
+    list->tail->next = list->head;                                         \
+    list->head->prev = list->tail;                                         \
+    list->tail = head->prev;                                               \
+    list->tail->next = NULL;                                               \
+    list->head = head;                                                     \
+    head->prev = NULL;                                                     \
+}                                                                          \
+                                                                           \
+static inline void name##_shift_left(name *list) {                         \
+    name##_rotate(list, 1);                                                \
+}                                                                          \
+                                                                           \
+static inline void name##_shift_right(name *list) {                        \
+    name##_rotate(list, -1);                                               \
+}                                                                          \
+                                                                           \
+static inline void name##_concat(name *list, name *other) {                \
+    if (!other->head) {                                                    \
+        return;                                                            \
+    }                                                                      \
+    other->head->prev = list->tail;                                        \
+    if (list->tail) {                                                      \
+        list->tail->next = other->head;                                    \
+    } else {                                                               \
+        list->head = other->head;                                          \
+    }                                                                      \
+    list->tail = other->tail;                                              \
+    list->size += other->size;                                             \
+    other->head = NULL;                                                    \
+    other->tail = NULL;                                                    \
+    other->size = 0;                                                       \
+}                                                                          \
+                                                                           \
+static inline name *name##_split_at(name *list, int index) {               \
+    if (index < 0 || (size_t) index > list->size) {                        \
+        return NULL;                                                       \
+    }                                                                      \
+    name *other = name##_new();                                            \
+    name##Node *node = name##_get_at(list, index);                         \
+    if (!node) {                                                           \
+        return other;                                                      \
+    }                                                                      \
+    other->head = node;                                                    \
+    other->tail = list->tail;                                              \
+    other->size = list->size - index;                                      \
+    list->tail = node->prev;                                               \
+    list->size = index;                                                    \
+    if (node->prev) {                                                      \
+        node->prev->next = NULL;                                           \
+    } else {                                                               \
+        list->head = NULL;                                                 \
+    }                                                                      \
+    node->prev = NULL;                                                     \
+    return other;                                                          \
+}                                                                          \
+                                                                           \
+static inline void name##_reverse(name *list) {                            \
+    name##Node *node = list->head;                                         \
+    while (node) {                                                         \
+        name##Node *next = node->next;                                     \
+        node->next = node->prev;                                           \
+        node->prev = next;                                                 \
+        node = next;                                                       \
+    }                                                                      \
+    node = list->head;                                                     \
+    list->head = list->tail;                                               \
+    list->tail = node;                                                     \
+}                                                                          \
+                                                                           \
+static inline void name##_delete(name *list, name##Node *node) {           \
+    name##_unlink(list, node);                                             \
+    destructor(&node->data);                                               \
+    LIST_FREE(node);                                                       \
+}                                                                          \
+                                                                           \
+static inline void name##_delete_at(name *list, int index) {               \
+    name##Node *node = name##_get_at(list, index);                         \
+    if (node) {                                                            \
+        name##_delete(list, node);                                         \
+    }                                                                      \
+}
+
+#endif
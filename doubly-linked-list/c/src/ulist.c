@@ -0,0 +1,261 @@
+#include <string.h>
+
+#include "alloc.h"
+#include "ulist.h"
+
+/*
+ * Internal helper functions
+ */
+static UBlock *UList_block_new(UList *list, UBlock *prev);
+static void UList_block_free(UList *list, UBlock *block);
+static UBlock *UList_find(UList *list, int *index);
+static void UList_insert(UList *list, UBlock *block, size_t offset, void *data);
+static void UList_remove(UList *list, UBlock *block, size_t offset);
+
+/*
+ * Creates a new UList
+ */
+UList *UList_new(Free free) {
+    UList *list = LIST_CALLOC(1, sizeof(UList));
+    list->free = free;
+    return list;
+}
+
+/*
+ * Free UList allocated memory
+ */
+void UList_free(UList *list) {
+    UList_clear(list);
+    LIST_FREE(list);
+}
+
+/*
+ * Creates a new UBlock linked after prev, or at head if prev is NULL
+ */
+static UBlock *UList_block_new(UList *list, UBlock *prev) {
+    UBlock *block = LIST_CALLOC(1, sizeof(UBlock));
+    block->prev = prev;
+    block->next = prev ? prev->next : list->head;
+    if (block->next) {
+        block->next->prev = block;
+    } else {
+        list->tail = block;
+    }
+    if (prev) {
+        prev->next = block;
+    } else {
+        list->head = block;
+    }
+    return block;
+}
+
+/*
+ * Unlink and free UBlock
+ */
+static void UList_block_free(UList *list, UBlock *block) {
+    if (block->prev) {
+        block->prev->next = block->next;
+    } else {
+        list->head = block->next;
+    }
+    if (block->next) {
+        block->next->prev = block->prev;
+    } else {
+        list->tail = block->prev;
+    }
+    LIST_FREE(block);
+}
+
+/*
+ * UList is empty ?
+ */
+int UList_is_empty(UList *list) {
+    return list->head ? 0 : 1;
+}
+
+/*
+ * UList has some element ?
+ */
+int UList_has_some(UList *list) {
+    return list->head ? 1 : 0;
+}
+
+/*
+ * Get element index
+ */
+int UList_get_index(UList *list, void *data) {
+    int index = 0;
+    for (UBlock *block = list->head; block; block = block->next) {
+        for (size_t i = 0; i < block->count; i++) {
+            if (block->items[i] == data) {
+                return index + i;
+            }
+        }
+        index += block->count;
+    }
+    return -1;
+}
+
+/*
+ * Find UBlock holding index, walking from the nearest end,
+ * and turn index into an offset inside it
+ */
+static UBlock *UList_find(UList *list, int *index) {
+    if (*index < 0 || (size_t) *index >= list->size) {
+        return NULL;
+    }
+
+    size_t position = *index;
+    if (position < list->size / 2) {
+        UBlock *block = list->head;
+        while (position >= block->count) {
+            position -= block->count;
+            block = block->next;
+        }
+        *index = position;
+        return block;
+    }
+
+    size_t start = list->size;
+    UBlock *block = list->tail;
+    while (position < start - block->count) {
+        start -= block->count;
+        block = block->prev;
+    }
+    *index = position - (start - block->count);
+    return block;
+}
+
+/*
+ * Get element at index
+ */
+void *UList_get_at(UList *list, int index) {
+    UBlock *block = UList_find(list, &index);
+    return block ? block->items[index] : NULL;
+}
+
+/*
+ * Insert element at offset, splitting a full UBlock in halves,
+ * unless appending or prepending to it, which starts a new one
+ */
+static void UList_insert(UList *list, UBlock *block, size_t offset, void *data) {
+    if (block->count == UBLOCK_SIZE && offset == UBLOCK_SIZE) {
+        block = UList_block_new(list, block);
+        offset = 0;
+
+    } else if (block->count == UBLOCK_SIZE && offset == 0) {
+        block = UList_block_new(list, block->prev);
+
+    } else if (block->count == UBLOCK_SIZE) {
+        UBlock *next = UList_block_new(list, block);
+        size_t half = UBLOCK_SIZE / 2;
+        next->count = UBLOCK_SIZE - half;
+        memcpy(next->items, block->items + half, next->count * sizeof(void *));
+        block->count = half;
+        if (offset > half) {
+            block = next;
+            offset -= half;
+        }
+    }
+
+    memmove(block->items + offset + 1, block->items + offset,
+            (block->count - offset) * sizeof(void *));
+    block->items[offset] = data;
+    block->count++;
+    list->size++;
+}
+
+/*
+ * Add element to UList head
+ */
+void UList_add_head(UList *list, void *data) {
+    UBlock *block = list->head ? list->head : UList_block_new(list, NULL);
+    UList_insert(list, block, 0, data);
+}
+
+/*
+ * Add element to UList tail
+ */
+void UList_add_tail(UList *list, void *data) {
+    UBlock *block = list->tail ? list->tail : UList_block_new(list, NULL);
+    UList_insert(list, block, block->count, data);
+}
+
+/*
+ * Add element at index
+ */
+int UList_add_at(UList *list, int index, void *data) {
+    UBlock *block = UList_find(list, &index);
+    if (!block) {
+        return 0;
+    }
+    UList_insert(list, block, index, data);
+    return 1;
+}
+
+/*
+ * Clear UList elements
+ */
+void UList_clear(UList *list) {
+    UBlock *block = list->head;
+    while (block) {
+        UBlock *next = block->next;
+        if (list->free) {
+            for (size_t i = 0; i < block->count; i++) {
+                list->free(block->items[i]);
+            }
+        }
+        LIST_FREE(block);
+        block = next;
+    }
+    list->head = NULL;
+    list->tail = NULL;
+    list->size = 0;
+}
+
+/*
+ * Remove element at offset, merging a less than half full
+ * UBlock with a neighbour when both fit in one
+ */
+static void UList_remove(UList *list, UBlock *block, size_t offset) {
+    if (list->free) {
+        list->free(block->items[offset]);
+    }
+    block->count--;
+    memmove(block->items + offset, block->items + offset + 1,
+            (block->count - offset) * sizeof(void *));
+    list->size--;
+
+    if (block->count == 0) {
+        UList_block_free(list, block);
+        return;
+    }
+    if (block->count >= UBLOCK_SIZE / 2) {
+        return;
+    }
+
+    UBlock *next = block->next;
+    if (next && block->count + next->count <= UBLOCK_SIZE) {
+        memcpy(block->items + block->count, next->items, next->count * sizeof(void *));
+        block->count += next->count;
+        UList_block_free(list, next);
+        return;
+    }
+
+    UBlock *prev = block->prev;
+    if (prev && prev->count + block->count <= UBLOCK_SIZE) {
+        memcpy(prev->items + prev->count, block->items, block->count * sizeof(void *));
+        prev->count += block->count;
+        UList_block_free(list, block);
+    }
+}
+
+/*
+ * Delete element at index from UList
+ */
+void UList_delete_at(UList *list, int index) {
+    UBlock *block = UList_find(list, &index);
+    if (block) {
+        UList_remove(list, block, index);
+    }
+}
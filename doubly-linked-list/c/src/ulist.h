@@ -0,0 +1,47 @@
+#ifndef ULIST_H
+#define ULIST_H
+
+#include <stdlib.h>
+
+#include "list.h"
+
+/*
+ * Unrolled List: every UBlock holds a cache line of elements,
+ * so scans take one miss per block instead of one per element
+ */
+#define UBLOCK_SIZE (64 / sizeof(void *))
+
+typedef struct UBlock UBlock;
+typedef struct UList UList;
+
+struct UBlock {
+    UBlock *next;
+    UBlock *prev;
+    size_t count;
+    void *items[UBLOCK_SIZE];
+};
+
+struct UList {
+    UBlock *head;
+    UBlock *tail;
+    size_t size;
+    Free free;
+};
+
+UList *UList_new(void (*free)(void *data));
+void UList_free(UList *list);
+
+int UList_is_empty(UList *list);
+int UList_has_some(UList *list);
+
+int UList_get_index(UList *list, void *data);
+void *UList_get_at(UList *list, int index);
+
+void UList_add_head(UList *list, void *data);
+void UList_add_tail(UList *list, void *data);
+int UList_add_at(UList *list, int index, void *data);
+
+void UList_clear(UList *list);
+void UList_delete_at(UList *list, int index);
+
+#endif
@@ -0,0 +1,163 @@
+#include "alloc.h"
+#include "xlist.h"
+
+#define XLIST_CHUNK 4096
+
+/*
+ * Internal helper functions
+ */
+static XNode *XList_other(XNode *node, XNode *neighbour);
+static XNode *XList_link(XList *list, XNode *prev, XNode *next, void *data);
+
+/*
+ * Creates a new XList
+ */
+XList *XList_new(Free free) {
+    XList *list = LIST_CALLOC(1, sizeof(XList));
+    list->pool = Pool_new(sizeof(XNode), XLIST_CHUNK);
+    list->free = free;
+    return list;
+}
+
+/*
+ * Free XList allocated memory
+ */
+void XList_free(XList *list) {
+    XList_clear(list);
+    Pool_free(list->pool);
+    LIST_FREE(list);
+}
+
+/*
+ * Neighbour of node on the other side of the given one
+ */
+static XNode *XList_other(XNode *node, XNode *neighbour) {
+    return (XNode *) (node->link ^ (uintptr_t) neighbour);
+}
+
+/*
+ * Get a cursor on the head
+ */
+XCursor XList_first(XList *list) {
+    XCursor cursor = { NULL, list->head };
+    return cursor;
+}
+
+/*
+ * Get a cursor on the tail, walking backwards
+ */
+XCursor XList_last(XList *list) {
+    XCursor cursor = { NULL, list->tail };
+    return cursor;
+}
+
+/*
+ * Move cursor one Node on, in the direction it walks
+ */
+void XList_next(XCursor *cursor) {
+    XNode *next = XList_other(cursor->node, cursor->prev);
+    cursor->prev = cursor->node;
+    cursor->node = next;
+}
+
+/*
+ * Move cursor one Node back, turning it around so
+ * XList_next keeps walking that way
+ */
+void XList_prev(XCursor *cursor) {
+    XNode *node = cursor->node;
+    cursor->node = cursor->prev;
+    cursor->prev = node;
+}
+
+/*
+ * Link a new Node between two adjacent ones, either may be NULL
+ */
+static XNode *XList_link(XList *list, XNode *prev, XNode *next, void *data) {
+    XNode *node = Pool_alloc(list->pool);
+    node->data = data;
+    node->link = (uintptr_t) prev ^ (uintptr_t) next;
+
+    if (prev) {
+        prev->link ^= (uintptr_t) next ^ (uintptr_t) node;
+    } else {
+        list->head = node;
+    }
+    if (next) {
+        next->link ^= (uintptr_t) prev ^ (uintptr_t) node;
+    } else {
+        list->tail = node;
+    }
+
+    list->size++;
+    return node;
+}
+
+/*
+ * Add data at the head
+ */
+XNode *XList_add_head(XList *list, void *data) {
+    return XList_link(list, NULL, list->head, data);
+}
+
+/*
+ * Add data at the tail
+ */
+XNode *XList_add_tail(XList *list, void *data) {
+    return XList_link(list, list->tail, NULL, data);
+}
+
+/*
+ * Reverse XList in O(1), links read the same either way
+ */
+void XList_reverse(XList *list) {
+    XNode *head = list->head;
+    list->head = list->tail;
+    list->tail = head;
+}
+
+/*
+ * Clear XList nodes, releasing their memory in bulk
+ */
+void XList_clear(XList *list) {
+    if (list->free) {
+        for (XCursor cursor = XList_first(list); cursor.node; XList_next(&cursor)) {
+            list->free(cursor.node->data);
+        }
+    }
+    Pool_clear(list->pool);
+    list->head = NULL;
+    list->tail = NULL;
+    list->size = 0;
+}
+
+/*
+ * Delete the Node under cursor, which moves on to the next one
+ */
+void XList_delete(XList *list, XCursor *cursor) {
+    XNode *node = cursor->node;
+    XNode *prev = cursor->prev;
+    XNode *next = XList_other(node, prev);
+
+    if (prev) {
+        prev->link ^= (uintptr_t) node ^ (uintptr_t) next;
+    } else if (list->head == node) {
+        list->head = next;
+    } else {
+        list->tail = next;
+    }
+    if (next) {
+        next->link ^= (uintptr_t) node ^ (uintptr_t) prev;
+    } else if (list->tail == node) {
+        list->tail = prev;
+    } else {
+        list->head = prev;
+    }
+
+    if (list->free) {
+        list->free(node->data);
+    }
+    Pool_release(list->pool, node);
+    list->size--;
+    cursor->node = next;
+}
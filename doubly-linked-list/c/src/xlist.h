@@ -0,0 +1,55 @@
+#ifndef XLIST_H
+#define XLIST_H
+
+#include <stdint.h>
+#include <stdlib.h>
+
+#include "list.h"
+#include "pool.h"
+
+/*
+ * List whose Nodes keep prev ^ next in a single link, allocated
+ * from a Pool of 16 byte slots. Walking needs two adjacent Nodes,
+ * which an XCursor holds, and reversing is swapping head and tail
+ */
+typedef struct XNode XNode;
+typedef struct XList XList;
+typedef struct XCursor XCursor;
+
+struct XNode {
+    void *data;
+    uintptr_t link;
+};
+
+struct XList {
+    XNode *head;
+    XNode *tail;
+    size_t size;
+    Pool *pool;
+    Free free;
+};
+
+/*
+ * Position on node, coming from prev. A NULL node is past either end
+ */
+struct XCursor {
+    XNode *prev;
+    XNode *node;
+};
+
+XList *XList_new(Free free);
+void XList_free(XList *list);
+
+XCursor XList_first(XList *list);
+XCursor XList_last(XList *list);
+void XList_next(XCursor *cursor);
+void XList_prev(XCursor *cursor);
+
+XNode *XList_add_head(XList *list, void *data);
+XNode *XList_add_tail(XList *list, void *data);
+
+void XList_reverse(XList *list);
+void XList_clear(XList *list);
+void XList_delete(XList *list, XCursor *cursor);
+
+#endif
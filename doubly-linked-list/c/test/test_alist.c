@@ -0,0 +1,154 @@
+#include <string.h>
+
+#include "vendor/unity.h"
+#include "../src/alist.h"
+
+#define LENGTH(xs) (sizeof(xs) / sizeof(xs[0]))
+
+void TEST_ASSERT_EQUAL_ALIST(AList *list, AHandle handles[], int size) {
+    AHandle forward = AList_first(list);
+    AHandle backward = AList_last(list);
+    for (int i = 0; i < size; i++) {
+        TEST_ASSERT_EQUAL_UINT64(handles[i], forward);
+        TEST_ASSERT_EQUAL_UINT64(handles[size - i - 1], backward);
+        forward = AList_next(list, forward);
+        backward = AList_prev(list, backward);
+    }
+    TEST_ASSERT_EQUAL_UINT64(0, forward);
+    TEST_ASSERT_EQUAL_UINT64(0, backward);
+    TEST_ASSERT_EQUAL_INT(size, list->size);
+}
+
+static int freed;
+
+static void count_free(void *data) {
+    (void) data;
+    freed++;
+}
+
+void test_alist_new(void) {
+    AList *list = AList_new(NULL);
+
+    TEST_ASSERT_EQUAL_INT(0, list->size);
+    TEST_ASSERT_EQUAL_UINT64(0, AList_first(list));
+    TEST_ASSERT_EQUAL_UINT64(0, AList_last(list));
+    TEST_ASSERT_FALSE(AList_is_valid(list, 0));
+    TEST_ASSERT_NULL(AList_get(list, 0));
+
+    AList_free(list);
+}
+
+void test_alist_add() {
+    AList *list = AList_new(NULL);
+    int items[4];
+
+    AHandle handle1 = AList_add_tail(list, &items[0]);
+    AHandle handle2 = AList_add_head(list, &items[1]);
+    AHandle handle3 = AList_add_after(list, handle2, &items[2]);
+    AHandle handle4 = AList_add_before(list, handle2, &items[3]);
+    AHandle handles[] = { handle4, handle2, handle3, handle1 };
+    TEST_ASSERT_EQUAL_ALIST(list, handles, LENGTH(handles));
+
+    TEST_ASSERT_EQUAL_PTR(&items[0], AList_get(list, handle1));
+    TEST_ASSERT_EQUAL_PTR(&items[1], AList_get(list, handle2));
+    TEST_ASSERT_EQUAL_PTR(&items[2], AList_get(list, handle3));
+    TEST_ASSERT_EQUAL_PTR(&items[3], AList_get(list, handle4));
+
+    AList_free(list);
+}
+
+void test_alist_stale() {
+    AList *list = AList_new(count_free);
+    int items[2];
+
+    AHandle handle1 = AList_add_tail(list, &items[0]);
+    AHandle handle2 = AList_add_tail(list, &items[1]);
+    freed = 0;
+    TEST_ASSERT_TRUE(AList_delete(list, handle1));
+    TEST_ASSERT_EQUAL_INT(1, freed);
+
+    TEST_ASSERT_FALSE(AList_is_valid(list, handle1));
+    TEST_ASSERT_FALSE(AList_delete(list, handle1));
+    TEST_ASSERT_NULL(AList_get(list, handle1));
+    TEST_ASSERT_EQUAL_UINT64(0, AList_next(list, handle1));
+    TEST_ASSERT_EQUAL_UINT64(0, AList_add_after(list, handle1, NULL));
+    TEST_ASSERT_EQUAL_INT(1, freed);
+
+    AHandle handle3 = AList_add_head(list, &items[0]);
+    TEST_ASSERT_EQUAL_UINT32(handle1 & UINT32_MAX, handle3 & UINT32_MAX);
+    TEST_ASSERT_TRUE(handle1 != handle3);
+    TEST_ASSERT_FALSE(AList_is_valid(list, handle1));
+    AHandle handles[] = { handle3, handle2 };
+    TEST_ASSERT_EQUAL_ALIST(list, handles, LENGTH(handles));
+
+    AList_clear(list);
+    TEST_ASSERT_EQUAL_INT(3, freed);
+    TEST_ASSERT_FALSE(AList_is_valid(list, handle2));
+    TEST_ASSERT_FALSE(AList_is_valid(list, handle3));
+    TEST_ASSERT_EQUAL_ALIST(list, NULL, 0);
+
+    AList_free(list);
+}
+
+void test_alist_grow() {
+    AList *list = AList_new(NULL);
+    AHandle handles[1000];
+
+    for (int i = 0; i < (int) LENGTH(handles); i++) {
+        handles[i] = AList_add_tail(list, (void *) (size_t) (i + 1));
+    }
+    TEST_ASSERT_TRUE(list->capacity > LENGTH(handles));
+    TEST_ASSERT_EQUAL_ALIST(list, handles, LENGTH(handles));
+    for (int i = 0; i < (int) LENGTH(handles); i++) {
+        TEST_ASSERT_EQUAL_PTR((void *) (size_t) (i + 1), AList_get(list, handles[i]));
+    }
+
+    for (int i = 0; i < (int) LENGTH(handles); i += 2) {
+        AList_delete(list, handles[i]);
+    }
+    uint32_t capacity = list->capacity;
+    for (int i = 0; i < (int) LENGTH(handles); i += 2) {
+        handles[i] = AList_add_before(list, handles[i + 1], NULL);
+    }
+    TEST_ASSERT_EQUAL_INT(capacity, list->capacity);
+    TEST_ASSERT_EQUAL_ALIST(list, handles, LENGTH(handles));
+
+    AList_free(list);
+}
+
+void test_alist_copy() {
+    AList *list = AList_new(count_free);
+    AList_reserve(list, 100);
+    TEST_ASSERT_TRUE(list->capacity > 100);
+
+    AHandle handle1 = AList_add_tail(list, NULL);
+    AHandle handle2 = AList_add_tail(list, NULL);
+    AList *copy = AList_copy(list);
+    TEST_ASSERT_NULL(copy->free);
+    TEST_ASSERT_TRUE(copy->nodes != list->nodes);
+    AHandle handles[] = { handle1, handle2 };
+    TEST_ASSERT_EQUAL_ALIST(copy, handles, LENGTH(handles));
+
+    AList_delete(copy, handle1);
+    TEST_ASSERT_TRUE(AList_is_valid(list, handle1));
+    TEST_ASSERT_FALSE(AList_is_valid(copy, handle1));
+
+    freed = 0;
+    AList_free(copy);
+    TEST_ASSERT_EQUAL_INT(0, freed);
+    AList_free(list);
+    TEST_ASSERT_EQUAL_INT(2, freed);
+}
+
+int main(void) {
+   UnityBegin("test/test_alist.c");
+
+   RUN_TEST(test_alist_new);
+   RUN_TEST(test_alist_add);
+   RUN_TEST(test_alist_stale);
+   RUN_TEST(test_alist_grow);
+   RUN_TEST(test_alist_copy);
+
+   UnityEnd();
+   return 0;
+}
@@ -0,0 +1,158 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include <pthread.h>
+#include <string.h>
+
+#include "vendor/unity.h"
+#include "../src/cache.h"
+
+#define OBJECTS (CACHE_MAGAZINE * 5)
+
+void test_cache_alloc_release(void) {
+    Cache cache = CACHE_INITIALIZER(sizeof(int[4]));
+
+    int *object1 = Cache_alloc(&cache);
+    int *object2 = Cache_alloc(&cache);
+    TEST_ASSERT_NOT_NULL(object1);
+    TEST_ASSERT_TRUE(object1 != object2);
+
+    memset(object1, 0xff, sizeof(int[4]));
+    Cache_release(&cache, object1);
+    int *object3 = Cache_alloc(&cache);
+    TEST_ASSERT_EQUAL_PTR(object1, object3);
+    for (int i = 0; i < 4; i++) {
+        TEST_ASSERT_EQUAL_INT(0, object3[i]);
+    }
+
+    Cache_release(&cache, object2);
+    Cache_release(&cache, object3);
+    Cache_flush(&cache);
+    Cache_trim(&cache);
+}
+
+void test_cache_depot() {
+    Cache cache = CACHE_INITIALIZER(sizeof(int));
+    void *objects[OBJECTS];
+
+    for (int i = 0; i < OBJECTS; i++) {
+        objects[i] = Cache_alloc(&cache);
+    }
+    for (int i = 0; i < OBJECTS; i++) {
+        Cache_release(&cache, objects[i]);
+    }
+
+    size_t full = 0;
+    for (Magazine *magazine = cache.full; magazine; magazine = magazine->next) {
+        TEST_ASSERT_EQUAL_INT(CACHE_MAGAZINE, magazine->count);
+        full++;
+    }
+    TEST_ASSERT_EQUAL_INT(OBJECTS / CACHE_MAGAZINE - 2, full);
+
+    for (int i = 0; i < OBJECTS; i++) {
+        void *object = Cache_alloc(&cache);
+        int found = 0;
+        for (int j = 0; j < OBJECTS && !found; j++) {
+            found = objects[j] == object;
+        }
+        TEST_ASSERT_TRUE(found);
+    }
+    TEST_ASSERT_NULL(cache.full);
+
+    for (int i = 0; i < OBJECTS; i++) {
+        Cache_release(&cache, objects[i]);
+    }
+    Cache_flush(&cache);
+    TEST_ASSERT_EQUAL_INT(OBJECTS, Cache_trim(&cache));
+    TEST_ASSERT_NULL(cache.full);
+    TEST_ASSERT_NULL(cache.empty);
+    TEST_ASSERT_EQUAL_INT(0, Cache_trim(&cache));
+}
+
+void test_cache_flush() {
+    Cache cache = CACHE_INITIALIZER(sizeof(int));
+
+    void *object = Cache_alloc(&cache);
+    Cache_release(&cache, object);
+    Cache_flush(&cache);
+    TEST_ASSERT_NOT_NULL(cache.full);
+    TEST_ASSERT_EQUAL_INT(1, cache.full->count);
+    TEST_ASSERT_NOT_NULL(cache.empty);
+
+    TEST_ASSERT_EQUAL_PTR(object, Cache_alloc(&cache));
+    Cache_release(&cache, object);
+    Cache_flush(&cache);
+    Cache_trim(&cache);
+}
+
+static Cache shared = CACHE_INITIALIZER(sizeof(int));
+static void *objects[OBJECTS];
+
+static void *release(void *arg) {
+    (void) arg;
+    for (int i = 0; i < OBJECTS; i++) {
+        Cache_release(&shared, objects[i]);
+    }
+    return NULL;
+}
+
+/*
+ * Objects allocated on one thread and released on another
+ * come back through the depot once the releasing thread exits
+ */
+void test_cache_threads() {
+    pthread_t thread;
+    for (int i = 0; i < OBJECTS; i++) {
+        objects[i] = Cache_alloc(&shared);
+    }
+    Cache_flush(&shared);
+
+    pthread_create(&thread, NULL, release, NULL);
+    pthread_join(thread, NULL);
+
+    size_t count = 0;
+    for (Magazine *magazine = shared.full; magazine; magazine = magazine->next) {
+        count += magazine->count;
+    }
+    TEST_ASSERT_EQUAL_INT(OBJECTS, count);
+
+    for (int i = 0; i < OBJECTS; i++) {
+        void *object = Cache_alloc(&shared);
+        int found = 0;
+        for (int j = 0; j < OBJECTS && !found; j++) {
+            found = objects[j] == object;
+        }
+        TEST_ASSERT_TRUE(found);
+        Cache_release(&shared, object);
+    }
+    Cache_flush(&shared);
+    Cache_trim(&shared);
+}
+
+void test_cache_slots() {
+    Cache caches[CACHE_THREAD_SLOTS + 1];
+    void *objects[CACHE_THREAD_SLOTS + 1];
+    for (int i = 0; i <= CACHE_THREAD_SLOTS; i++) {
+        Cache cache = CACHE_INITIALIZER(sizeof(int));
+        caches[i] = cache;
+        objects[i] = Cache_alloc(&caches[i]);
+    }
+    for (int i = 0; i <= CACHE_THREAD_SLOTS; i++) {
+        Cache_release(&caches[i], objects[i]);
+        Cache_flush(&caches[i]);
+        Cache_trim(&caches[i]);
+    }
+    TEST_ASSERT_NULL(caches[CACHE_THREAD_SLOTS].full);
+}
+
+int main(void) {
+   UnityBegin("test/test_cache.c");
+
+   RUN_TEST(test_cache_alloc_release);
+   RUN_TEST(test_cache_depot);
+   RUN_TEST(test_cache_flush);
+   RUN_TEST(test_cache_threads);
+   RUN_TEST(test_cache_slots);
+
+   UnityEnd();
+   return 0;
+}
@@ -0,0 +1,223 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include <pthread.h>
+
+#include "vendor/unity.h"
+#include "../src/clist.h"
+
+#define THREADS 4
+#define SLOTS   64
+#define ROUNDS  20000
+
+void TEST_ASSERT_EQUAL_CLIST(CList *list, CNode *nodes[], int size) {
+    CNode *prev = list->head;
+    for (int i = 0; i < size; i++) {
+        CNode *node = atomic_load(&prev->next);
+        TEST_ASSERT_EQUAL_PTR(nodes[i], node);
+        TEST_ASSERT_EQUAL_PTR(prev, atomic_load(&node->prev));
+        prev = node;
+    }
+    TEST_ASSERT_EQUAL_PTR(list->tail, atomic_load(&prev->next));
+    TEST_ASSERT_EQUAL_PTR(prev, atomic_load(&list->tail->prev));
+    TEST_ASSERT_EQUAL_INT(size, CList_size(list));
+}
+
+void test_clist_new(void) {
+    CList *list = CList_new(free);
+
+    TEST_ASSERT_EQUAL_INT(0, CList_size(list));
+    TEST_ASSERT_NULL(CList_first(list));
+    TEST_ASSERT_EQUAL_CLIST(list, NULL, 0);
+
+    CList_free(list);
+}
+
+void test_clist_add() {
+    CList *list = CList_new(NULL);
+    CThread *thread = CList_register(list);
+
+    CNode *node1 = CList_add_tail(list, thread, NULL);
+    CNode *node2 = CList_add_head(list, thread, NULL);
+    CNode *node3 = CList_add_before(list, thread, node1, NULL);
+    CNode *node4 = CList_add_after(list, thread, node1, NULL);
+
+    CNode *nodes[] = { node2, node3, node1, node4 };
+    TEST_ASSERT_EQUAL_CLIST(list, nodes, 4);
+    TEST_ASSERT_EQUAL_PTR(node2, CList_first(list));
+    TEST_ASSERT_EQUAL_PTR(node3, CList_next(list, node2));
+    TEST_ASSERT_NULL(CList_next(list, node4));
+
+    CList_unregister(thread);
+    CList_free(list);
+}
+
+void test_clist_delete() {
+    CList *list = CList_new(free);
+    CThread *thread = CList_register(list);
+
+    CNode *node1 = CList_add_tail(list, thread, malloc(sizeof(int)));
+    CNode *node2 = CList_add_tail(list, thread, malloc(sizeof(int)));
+    CNode *node3 = CList_add_tail(list, thread, malloc(sizeof(int)));
+
+    TEST_ASSERT_TRUE(CList_delete(list, thread, node2));
+    CNode *nodes[] = { node1, node3 };
+    TEST_ASSERT_EQUAL_CLIST(list, nodes, 2);
+
+    Epoch_enter(thread->handle);
+    TEST_ASSERT_TRUE(CList_delete(list, thread, node1));
+    TEST_ASSERT_FALSE(CList_delete(list, thread, node1));
+    TEST_ASSERT_NULL(CList_add_after(list, thread, node1, NULL));
+    TEST_ASSERT_NULL(CList_add_before(list, thread, node1, NULL));
+    TEST_ASSERT_FALSE(CList_swap(list, thread, node1, node3));
+    Epoch_exit(thread->handle);
+
+    CNode *nodes2[] = { node3 };
+    TEST_ASSERT_EQUAL_CLIST(list, nodes2, 1);
+
+    CList_unregister(thread);
+    CList_free(list);
+}
+
+void test_clist_swap() {
+    CList *list = CList_new(NULL);
+    CThread *thread = CList_register(list);
+
+    CNode *node1 = CList_add_tail(list, thread, NULL);
+    CNode *node2 = CList_add_tail(list, thread, NULL);
+    CNode *node3 = CList_add_tail(list, thread, NULL);
+    CNode *node4 = CList_add_tail(list, thread, NULL);
+
+    CList_swap(list, thread, node1, node2);
+    CNode *nodes1[] = { node2, node1, node3, node4 };
+    TEST_ASSERT_EQUAL_CLIST(list, nodes1, 4);
+
+    CList_swap(list, thread, node3, node1);
+    CNode *nodes2[] = { node2, node3, node1, node4 };
+    TEST_ASSERT_EQUAL_CLIST(list, nodes2, 4);
+
+    CList_swap(list, thread, node2, node4);
+    CNode *nodes3[] = { node4, node3, node1, node2 };
+    TEST_ASSERT_EQUAL_CLIST(list, nodes3, 4);
+
+    CList_swap(list, thread, node3, node3);
+    TEST_ASSERT_EQUAL_CLIST(list, nodes3, 4);
+
+    CList_unregister(thread);
+    CList_free(list);
+}
+
+void test_clist_size() {
+    CList *list = CList_new(NULL);
+    CThread *adder = CList_register(list);
+    CThread *deleter = CList_register(list);
+
+    CNode *node1 = CList_add_tail(list, adder, NULL);
+    CNode *node2 = CList_add_tail(list, adder, NULL);
+    CList_add_tail(list, adder, NULL);
+    TEST_ASSERT_EQUAL_INT(3, CList_size(list));
+
+    CList_delete(list, deleter, node1);
+    CList_delete(list, deleter, node2);
+    TEST_ASSERT_EQUAL_INT(-2, atomic_load(&deleter->count));
+    TEST_ASSERT_EQUAL_INT(1, CList_size(list));
+
+    CList_unregister(adder);
+    TEST_ASSERT_EQUAL_INT(1, CList_size(list));
+    CThread *reused = CList_register(list);
+    TEST_ASSERT_EQUAL_PTR(adder, reused);
+    TEST_ASSERT_EQUAL_INT(3, atomic_load(&reused->count));
+    CList_unregister(reused);
+    CList_unregister(deleter);
+    CList_free(list);
+}
+
+static CList *shared;
+static _Atomic(CNode *) slots[THREADS * SLOTS];
+
+static size_t random_next(size_t *state) {
+    *state ^= *state << 13;
+    *state ^= *state >> 7;
+    *state ^= *state << 17;
+    return *state;
+}
+
+/*
+ * Replace own CNodes with new ones and swap them with CNodes
+ * anywhere in the list, other threads doing the same
+ */
+static void *work(void *arg) {
+    int id = *(int *) arg;
+    size_t state = id + 1;
+    CThread *thread = CList_register(shared);
+
+    for (int round = 0; round < ROUNDS; round++) {
+        int slot = id * SLOTS + random_next(&state) % SLOTS;
+        CNode *mine = atomic_load(&slots[slot]);
+
+        if (round % 2) {
+            CNode *node = CList_add_after(shared, thread, mine, malloc(sizeof(int)));
+            atomic_store(&slots[slot], node);
+            CList_delete(shared, thread, mine);
+        } else {
+            Epoch_enter(thread->handle);
+            CNode *other = atomic_load(&slots[random_next(&state) % (THREADS * SLOTS)]);
+            CList_swap(shared, thread, mine, other);
+            Epoch_exit(thread->handle);
+        }
+    }
+
+    CList_unregister(thread);
+    return NULL;
+}
+
+void test_clist_threads() {
+    shared = CList_new(free);
+    CThread *thread = CList_register(shared);
+    for (int i = 0; i < THREADS * SLOTS; i++) {
+        atomic_store(&slots[i], CList_add_tail(shared, thread, malloc(sizeof(int))));
+    }
+
+    pthread_t threads[THREADS];
+    int ids[THREADS];
+    for (int i = 0; i < THREADS; i++) {
+        ids[i] = i;
+        pthread_create(&threads[i], NULL, work, &ids[i]);
+    }
+    for (int i = 0; i < THREADS; i++) {
+        pthread_join(threads[i], NULL);
+    }
+
+    int seen[THREADS * SLOTS] = { 0 };
+    int size = 0;
+    CNode *prev = shared->head;
+    for (CNode *node = CList_first(shared); node; node = CList_next(shared, node)) {
+        TEST_ASSERT_EQUAL_PTR(prev, atomic_load(&node->prev));
+        for (int i = 0; i < THREADS * SLOTS; i++) {
+            seen[i] += atomic_load(&slots[i]) == node;
+        }
+        prev = node;
+        size++;
+    }
+    TEST_ASSERT_EQUAL_INT(THREADS * SLOTS, size);
+    TEST_ASSERT_EQUAL_INT(THREADS * SLOTS, CList_size(shared));
+    for (int i = 0; i < THREADS * SLOTS; i++) {
+        TEST_ASSERT_EQUAL_INT(1, seen[i]);
+    }
+
+    CList_unregister(thread);
+    CList_free(shared);
+}
+
+int main(void) {
+   UnityBegin("test/test_clist.c");
+
+   RUN_TEST(test_clist_new);
+   RUN_TEST(test_clist_add);
+   RUN_TEST(test_clist_delete);
+   RUN_TEST(test_clist_swap);
+   RUN_TEST(test_clist_size);
+   RUN_TEST(test_clist_threads);
+
+   UnityEnd();
+   return 0;
+}
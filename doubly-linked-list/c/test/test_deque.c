@@ -0,0 +1,174 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include <pthread.h>
+
+#include "vendor/unity.h"
+#include "../src/deque.h"
+
+#define THREADS 4
+#define ITEMS   20000
+
+void TEST_ASSERT_EQUAL_DEQUE(Deque *deque, EpochThread *thread, int *items[], int size) {
+    void *data;
+    for (int i = 0; i < size; i++) {
+        TEST_ASSERT_TRUE(Deque_pop_head(deque, thread, &data));
+        TEST_ASSERT_EQUAL_PTR(items[i], data);
+    }
+    TEST_ASSERT_FALSE(Deque_pop_head(deque, thread, &data));
+    TEST_ASSERT_TRUE(Deque_is_empty(deque, thread));
+}
+
+void test_deque_new(void) {
+    Deque *deque = Deque_new(free);
+    EpochThread *thread = Deque_register(deque);
+    void *data = NULL;
+
+    TEST_ASSERT_TRUE(Deque_is_empty(deque, thread));
+    TEST_ASSERT_FALSE(Deque_pop_head(deque, thread, &data));
+    TEST_ASSERT_FALSE(Deque_pop_tail(deque, thread, &data));
+    TEST_ASSERT_NULL(data);
+
+    Deque_unregister(thread);
+    Deque_free(deque);
+}
+
+void test_deque_add() {
+    Deque *deque = Deque_new(NULL);
+    EpochThread *thread = Deque_register(deque);
+    int a, b, c, d;
+
+    Deque_add_tail(deque, thread, &a);
+    Deque_add_tail(deque, thread, &b);
+    Deque_add_head(deque, thread, &c);
+    Deque_add_head(deque, thread, &d);
+    TEST_ASSERT_FALSE(Deque_is_empty(deque, thread));
+
+    int *items[] = { &d, &c, &a, &b };
+    TEST_ASSERT_EQUAL_DEQUE(deque, thread, items, 4);
+
+    Deque_unregister(thread);
+    Deque_free(deque);
+}
+
+void test_deque_pop() {
+    Deque *deque = Deque_new(NULL);
+    EpochThread *thread = Deque_register(deque);
+    int a, b, c;
+    void *data;
+
+    Deque_add_tail(deque, thread, &a);
+    Deque_add_tail(deque, thread, &b);
+    Deque_add_tail(deque, thread, &c);
+
+    TEST_ASSERT_TRUE(Deque_pop_tail(deque, thread, &data));
+    TEST_ASSERT_EQUAL_PTR(&c, data);
+    TEST_ASSERT_TRUE(Deque_pop_head(deque, thread, &data));
+    TEST_ASSERT_EQUAL_PTR(&a, data);
+    TEST_ASSERT_TRUE(Deque_pop_tail(deque, thread, &data));
+    TEST_ASSERT_EQUAL_PTR(&b, data);
+    TEST_ASSERT_FALSE(Deque_pop_tail(deque, thread, &data));
+
+    Deque_add_head(deque, thread, &a);
+    TEST_ASSERT_TRUE(Deque_pop_tail(deque, thread, &data));
+    TEST_ASSERT_EQUAL_PTR(&a, data);
+
+    Deque_unregister(thread);
+    Deque_free(deque);
+}
+
+void test_deque_free() {
+    Deque *deque = Deque_new(free);
+    EpochThread *thread = Deque_register(deque);
+
+    for (int i = 0; i < 100; i++) {
+        int *item = malloc(sizeof(int));
+        if (i % 2) {
+            Deque_add_head(deque, thread, item);
+        } else {
+            Deque_add_tail(deque, thread, item);
+        }
+    }
+
+    Deque_unregister(thread);
+    Deque_free(deque);
+}
+
+typedef struct {
+    Deque *deque;
+    int id;
+    atomic_int *seen;
+} Worker;
+
+/*
+ * Push ITEMS elements at either end and pop as many from either
+ * end, marking every popped element as seen
+ */
+static void *work(void *arg) {
+    Worker *worker = arg;
+    EpochThread *thread = Deque_register(worker->deque);
+    for (int i = 0; i < ITEMS; i++) {
+        int *item = malloc(sizeof(int));
+        *item = worker->id * ITEMS + i;
+        if (i % 2) {
+            Deque_add_head(worker->deque, thread, item);
+        } else {
+            Deque_add_tail(worker->deque, thread, item);
+        }
+
+        void *data;
+        int found = (i + worker->id) % 2
+            ? Deque_pop_head(worker->deque, thread, &data)
+            : Deque_pop_tail(worker->deque, thread, &data);
+        if (found) {
+            atomic_fetch_add(&worker->seen[*(int *) data], 1);
+            free(data);
+        }
+    }
+
+    Deque_unregister(thread);
+    return NULL;
+}
+
+void test_deque_threads() {
+    Deque *deque = Deque_new(free);
+    atomic_int *seen = calloc(THREADS * ITEMS, sizeof(atomic_int));
+    pthread_t threads[THREADS];
+    Worker workers[THREADS];
+
+    for (int i = 0; i < THREADS; i++) {
+        workers[i].deque = deque;
+        workers[i].id = i;
+        workers[i].seen = seen;
+        pthread_create(&threads[i], NULL, work, &workers[i]);
+    }
+    for (int i = 0; i < THREADS; i++) {
+        pthread_join(threads[i], NULL);
+    }
+
+    EpochThread *thread = Deque_register(deque);
+    void *data;
+    while (Deque_pop_head(deque, thread, &data)) {
+        seen[*(int *) data]++;
+        free(data);
+    }
+    for (int i = 0; i < THREADS * ITEMS; i++) {
+        TEST_ASSERT_EQUAL_INT(1, atomic_load(&seen[i]));
+    }
+
+    Deque_unregister(thread);
+    Deque_free(deque);
+    free(seen);
+}
+
+int main(void) {
+   UnityBegin("test/test_deque.c");
+
+   RUN_TEST(test_deque_new);
+   RUN_TEST(test_deque_add);
+   RUN_TEST(test_deque_pop);
+   RUN_TEST(test_deque_free);
+   RUN_TEST(test_deque_threads);
+
+   UnityEnd();
+   return 0;
+}
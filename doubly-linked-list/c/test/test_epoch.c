@@ -0,0 +1,107 @@
+#include "vendor/unity.h"
+#include "../src/epoch.h"
+
+static int freed;
+
+static void count_free(void *ptr) {
+    (void) ptr;
+    freed++;
+}
+
+void test_epoch_new(void) {
+    Epoch *epoch = Epoch_new();
+
+    TEST_ASSERT_EQUAL_INT(0, atomic_load(&epoch->global));
+    TEST_ASSERT_NULL(atomic_load(&epoch->threads));
+
+    Epoch_free(epoch);
+}
+
+void test_epoch_register() {
+    Epoch *epoch = Epoch_new();
+
+    EpochThread *thread1 = Epoch_register(epoch);
+    EpochThread *thread2 = Epoch_register(epoch);
+    TEST_ASSERT_NOT_EQUAL(thread1, thread2);
+
+    Epoch_unregister(thread1);
+    TEST_ASSERT_EQUAL_PTR(thread1, Epoch_register(epoch));
+
+    Epoch_free(epoch);
+}
+
+void test_epoch_retire() {
+    Epoch *epoch = Epoch_new();
+    EpochThread *thread = Epoch_register(epoch);
+    int item;
+
+    freed = 0;
+    Epoch_enter(thread);
+    Epoch_retire(thread, &item, count_free);
+    Epoch_collect(thread);
+    Epoch_collect(thread);
+    TEST_ASSERT_EQUAL_INT(0, freed);
+    Epoch_exit(thread);
+
+    Epoch_collect(thread);
+    TEST_ASSERT_EQUAL_INT(1, freed);
+    TEST_ASSERT_EQUAL_INT(thread->first, thread->count);
+
+    Epoch_free(epoch);
+}
+
+void test_epoch_critical_section() {
+    Epoch *epoch = Epoch_new();
+    EpochThread *reader = Epoch_register(epoch);
+    EpochThread *writer = Epoch_register(epoch);
+    int item;
+
+    freed = 0;
+    Epoch_enter(reader);
+    Epoch_enter(reader);
+    Epoch_exit(reader);
+    Epoch_retire(writer, &item, count_free);
+    for (int i = 0; i < 10; i++) {
+        Epoch_collect(writer);
+    }
+    TEST_ASSERT_EQUAL_INT(0, freed);
+
+    Epoch_exit(reader);
+    for (int i = 0; i < 3; i++) {
+        Epoch_collect(writer);
+    }
+    TEST_ASSERT_EQUAL_INT(1, freed);
+
+    Epoch_free(epoch);
+}
+
+void test_epoch_free() {
+    Epoch *epoch = Epoch_new();
+    EpochThread *thread = Epoch_register(epoch);
+    int items[100];
+
+    freed = 0;
+    Epoch_enter(thread);
+    for (int i = 0; i < 100; i++) {
+        Epoch_retire(thread, &items[i], count_free);
+    }
+    Epoch_exit(thread);
+    Epoch_unregister(thread);
+    TEST_ASSERT_TRUE(freed < 100);
+
+    Epoch_free(epoch);
+    TEST_ASSERT_EQUAL_INT(100, freed);
+}
+
+int main(void) {
+   UnityBegin("test/test_epoch.c");
+
+   RUN_TEST(test_epoch_new);
+   RUN_TEST(test_epoch_register);
+   RUN_TEST(test_epoch_retire);
+   RUN_TEST(test_epoch_critical_section);
+   RUN_TEST(test_epoch_free);
+
+   UnityEnd();
+   return 0;
+}
@@ -0,0 +1,175 @@
+#include "vendor/unity.h"
+#include "../src/ilist.h"
+
+#define LENGTH(xs) (sizeof(xs) / sizeof(xs[0]))
+
+typedef struct {
+    int value;
+    ILink link;
+} Item;
+
+void TEST_ASSERT_EQUAL_ILIST(IList *list, Item *items[], int size) {
+    ILink *forward = list->head;
+    ILink *backward = list->tail;
+    TEST_ASSERT_EQUAL_INT(size, list->size);
+    for (int i = 0; i < size; i++) {
+        TEST_ASSERT_EQUAL_PTR(items[i], IList_entry(forward, Item, link));
+        TEST_ASSERT_EQUAL_PTR(items[size-i-1], IList_entry(backward, Item, link));
+        forward = forward->next;
+        backward = backward->prev;
+    }
+    TEST_ASSERT_NULL(forward);
+    TEST_ASSERT_NULL(backward);
+}
+
+void test_ilist_new(void) {
+    IList *list = IList_new();
+
+    TEST_ASSERT_NULL(list->head);
+    TEST_ASSERT_NULL(list->tail);
+    TEST_ASSERT_EQUAL_INT(0, list->size);
+    TEST_ASSERT_TRUE(IList_is_empty(list));
+    TEST_ASSERT_FALSE(IList_has_some(list));
+
+    IList_free(list);
+}
+
+void test_ilist_entry(void) {
+    Item item = { 42, { NULL, NULL } };
+
+    TEST_ASSERT_EQUAL_PTR(&item, IList_entry(&item.link, Item, link));
+    TEST_ASSERT_EQUAL_INT(42, IList_entry(&item.link, Item, link)->value);
+}
+
+void test_ilist_add() {
+    IList *list = IList_new();
+    Item item1, item2, item3, item4, item5;
+
+    IList_add_tail(list, &item1.link);
+    IList_add_head(list, &item2.link);
+    Item *items1[] = { &item2, &item1 };
+    TEST_ASSERT_EQUAL_ILIST(list, items1, LENGTH(items1));
+
+    IList_add_before(list, &item1.link, &item3.link);
+    IList_add_after(list, &item1.link, &item4.link);
+    Item *items2[] = { &item2, &item3, &item1, &item4 };
+    TEST_ASSERT_EQUAL_ILIST(list, items2, LENGTH(items2));
+
+    TEST_ASSERT_NULL(IList_add_at(list, 4, &item5.link));
+    TEST_ASSERT_EQUAL_PTR(&item5.link, IList_add_at(list, 1, &item5.link));
+    Item *items3[] = { &item2, &item5, &item3, &item1, &item4 };
+    TEST_ASSERT_EQUAL_ILIST(list, items3, LENGTH(items3));
+
+    TEST_ASSERT_TRUE(IList_contains(list, &item3.link));
+    TEST_ASSERT_EQUAL_INT(2, IList_get_index(list, &item3.link));
+    TEST_ASSERT_EQUAL_PTR(&item1.link, IList_get_at(list, 3));
+    TEST_ASSERT_NULL(IList_get_at(list, 5));
+
+    IList_free(list);
+}
+
+void test_ilist_swap() {
+    IList *list = IList_new();
+    Item item1, item2, item3, item4, item5;
+    Item *items[] = { &item1, &item2, &item3, &item4, &item5 };
+    for (int i = 0; i < (int) LENGTH(items); i++) {
+        IList_add_tail(list, &items[i]->link);
+    }
+
+    IList_swap(list, &item1.link, &item2.link);
+    Item *items1[] = { &item2, &item1, &item3, &item4, &item5 };
+    TEST_ASSERT_EQUAL_ILIST(list, items1, LENGTH(items1));
+
+    IList_swap(list, &item2.link, &item5.link);
+    Item *items2[] = { &item5, &item1, &item3, &item4, &item2 };
+    TEST_ASSERT_EQUAL_ILIST(list, items2, LENGTH(items2));
+
+    IList_swap(list, &item4.link, &item1.link);
+    Item *items3[] = { &item5, &item4, &item3, &item1, &item2 };
+    TEST_ASSERT_EQUAL_ILIST(list, items3, LENGTH(items3));
+
+    IList_free(list);
+}
+
+void test_ilist_shift() {
+    IList *list = IList_new();
+    Item item1, item2, item3;
+    IList_add_tail(list, &item1.link);
+    IList_add_tail(list, &item2.link);
+    IList_add_tail(list, &item3.link);
+
+    IList_shift_left(list);
+    Item *items1[] = { &item2, &item3, &item1 };
+    TEST_ASSERT_EQUAL_ILIST(list, items1, LENGTH(items1));
+
+    IList_shift_right(list);
+    IList_shift_right(list);
+    Item *items2[] = { &item3, &item1, &item2 };
+    TEST_ASSERT_EQUAL_ILIST(list, items2, LENGTH(items2));
+
+    IList_free(list);
+}
+
+void test_ilist_reverse() {
+    IList *list = IList_new();
+    Item item1, item2, item3, item4;
+
+    IList_reverse(list);
+    TEST_ASSERT_NULL(list->head);
+
+    IList_add_tail(list, &item1.link);
+    IList_add_tail(list, &item2.link);
+    IList_add_tail(list, &item3.link);
+    IList_add_tail(list, &item4.link);
+
+    IList_reverse(list);
+    Item *items1[] = { &item4, &item3, &item2, &item1 };
+    TEST_ASSERT_EQUAL_ILIST(list, items1, LENGTH(items1));
+
+    IList_reverse(list);
+    Item *items2[] = { &item1, &item2, &item3, &item4 };
+    TEST_ASSERT_EQUAL_ILIST(list, items2, LENGTH(items2));
+
+    IList_free(list);
+}
+
+void test_ilist_delete() {
+    IList *list = IList_new();
+    Item item1, item2, item3, item4;
+    IList_add_tail(list, &item1.link);
+    IList_add_tail(list, &item2.link);
+    IList_add_tail(list, &item3.link);
+    IList_add_tail(list, &item4.link);
+
+    IList_delete(list, &item1.link);
+    Item *items1[] = { &item2, &item3, &item4 };
+    TEST_ASSERT_EQUAL_ILIST(list, items1, LENGTH(items1));
+
+    TEST_ASSERT_EQUAL_PTR(&item3.link, IList_delete_at(list, 1));
+    Item *items2[] = { &item2, &item4 };
+    TEST_ASSERT_EQUAL_ILIST(list, items2, LENGTH(items2));
+
+    TEST_ASSERT_NULL(IList_delete_at(list, 2));
+
+    IList_clear(list);
+    TEST_ASSERT_NULL(list->head);
+    TEST_ASSERT_NULL(list->tail);
+    TEST_ASSERT_EQUAL_INT(0, list->size);
+
+    IList_free(list);
+}
+
+int main(void) {
+   UnityBegin("test/test_ilist.c");
+
+   RUN_TEST(test_ilist_new);
+   RUN_TEST(test_ilist_entry);
+   RUN_TEST(test_ilist_add);
+   RUN_TEST(test_ilist_swap);
+   RUN_TEST(test_ilist_shift);
+   RUN_TEST(test_ilist_reverse);
+   RUN_TEST(test_ilist_delete);
+
+   UnityEnd();
+   return 0;
+}
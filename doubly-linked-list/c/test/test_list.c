@@ -1,4 +1,7 @@
+#include <string.h>
+
 #include "vendor/unity.h"
+#include "../src/cache.h"
 #include "../src/list.h"
 
 #define LENGTH(xs) (sizeof(xs) / sizeof(xs[0]))
@@ -14,16 +17,97 @@ void TEST_ASSERT_EQUAL_LIST(List *list, Node *nodes[], int size) {
     }
 }
 
+void TEST_ASSERT_EQUAL_INDEX(List *list, Node *nodes[], int size) {
+    TEST_ASSERT_EQUAL_LIST(list, nodes, size);
+    TEST_ASSERT_EQUAL_INT(size, list->size);
+    for (int i = 0; i < size; i++) {
+        TEST_ASSERT_EQUAL_PTR(nodes[i], List_get_at(list, i));
+        TEST_ASSERT_EQUAL_INT(i, List_get_index(list, nodes[i]));
+    }
+    TEST_ASSERT_NULL(List_get_at(list, -1));
+    TEST_ASSERT_NULL(List_get_at(list, size));
+}
+
 void test_list_new(void) {
     List *list = List_new(free);
 
     TEST_ASSERT_NULL(list->head);
     TEST_ASSERT_NULL(list->tail);
     TEST_ASSERT_NULL(list->current);
+    TEST_ASSERT_NULL(list->lookup);
+    TEST_ASSERT_EQUAL_INT(4 * sizeof(void *), sizeof(Node));
 
     List_free(list);
 }
 
+void test_list_new_cached(void) {
+    List *list = List_new_cached(NULL);
+    int item;
+
+    TEST_ASSERT_TRUE(list->cached);
+    Node *node1 = List_add_tail(list, &item);
+    Node *node2 = List_add_tail(list, NULL);
+    Node *nodes1[] = { node1, node2 };
+    TEST_ASSERT_EQUAL_LIST(list, nodes1, LENGTH(nodes1));
+
+    List_delete(list, node2);
+    Node *node3 = List_add_head(list, NULL);
+    TEST_ASSERT_EQUAL_PTR(node2, node3);
+    TEST_ASSERT_EQUAL_PTR(node1, node3->next);
+
+    List *other = List_split_at(list, 1);
+    TEST_ASSERT_TRUE(other->cached);
+
+    List_free(other);
+    List_free(list);
+}
+
+void test_list_cache_trim(void) {
+    List *list = List_new_cached(NULL);
+    for (int i = 0; i < 1000; i++) {
+        List_add_tail(list, NULL);
+    }
+    List_free(list);
+
+    size_t trimmed = List_cache_trim();
+    TEST_ASSERT_TRUE(trimmed <= 1000 - CACHE_MAGAZINE);
+    List_cache_flush();
+    trimmed += List_cache_trim();
+    TEST_ASSERT_TRUE(trimmed >= 1000);
+    TEST_ASSERT_EQUAL_INT(0, List_cache_trim());
+
+    list = List_new_cached(NULL);
+    List_add_tail(list, NULL);
+    List_free(list);
+    List_cache_flush();
+    TEST_ASSERT_EQUAL_INT(1, List_cache_trim());
+}
+
+void test_list_new_pooled(void) {
+    Pool *pool = Pool_new(sizeof(Node), 2);
+    List *list = List_new_pooled(free, pool);
+
+    TEST_ASSERT_EQUAL_PTR(pool, list->pool);
+    TEST_ASSERT_EQUAL_INT(2, pool->refs);
+
+    Node *node1 = List_add_tail(list, NULL);
+    Node *node2 = List_add_tail(list, NULL);
+    Node *node3 = List_add_tail(list, NULL);
+    Node *nodes1[] = { node1, node2, node3 };
+    TEST_ASSERT_EQUAL_LIST(list, nodes1, LENGTH(nodes1));
+    TEST_ASSERT_EQUAL_INT(3, pool->used);
+
+    List_delete(list, node2);
+    TEST_ASSERT_EQUAL_INT(2, pool->used);
+    TEST_ASSERT_EQUAL_PTR(node2, List_add_head(list, NULL));
+
+    List_free(list);
+    TEST_ASSERT_EQUAL_INT(1, pool->refs);
+    TEST_ASSERT_EQUAL_INT(0, pool->used);
+
+    Pool_free(pool);
+}
+
 void test_list_add_head() {
     List *list = List_new(free);
 
@@ -246,7 +330,7 @@ void test_list_contains() {
 
     TEST_ASSERT_FALSE(List_contains(list, NULL));
 
-    Node node6;
+    Node node6 = { 0 };
     TEST_ASSERT_FALSE(List_contains(list, &node6));
 
     TEST_ASSERT_TRUE(List_contains(list, node1));
@@ -258,6 +342,58 @@ void test_list_contains() {
     List_free(list);
 }
 
+void test_list_contains_owner() {
+    List *list1 = List_new(free);
+    List *list2 = List_new(free);
+
+    Node *node1 = List_add_tail(list1, NULL);
+    Node *node2 = List_add_tail(list2, NULL);
+    TEST_ASSERT_TRUE(List_contains(list1, node1));
+    TEST_ASSERT_FALSE(List_contains(list1, node2));
+    TEST_ASSERT_FALSE(List_contains(list2, node1));
+    TEST_ASSERT_TRUE(List_contains(list2, node2));
+    TEST_ASSERT_EQUAL_INT(-1, List_get_index(list1, node2));
+
+    Node *node3 = List_add_head(list1, NULL);
+    List_swap(list1, node1, node3);
+    TEST_ASSERT_TRUE(List_contains(list1, node1));
+    TEST_ASSERT_TRUE(List_contains(list1, node3));
+
+    List_free(list1);
+    List_free(list2);
+}
+
+void test_list_is_before() {
+    List *list = List_new(free);
+
+    Node *node1 = List_add_tail(list, NULL);
+    Node *node2 = List_add_tail(list, NULL);
+    Node *node3 = List_add_tail(list, NULL);
+    Node *node4 = List_add_tail(list, NULL);
+    Node *node5 = List_add_tail(list, NULL);
+    Node *nodes[] = { node1, node2, node3, node4, node5 };
+
+    for (int indexed = 0; indexed < 2; indexed++) {
+        if (indexed) {
+            List_index(list);
+        }
+        for (int i = 0; i < (int) LENGTH(nodes); i++) {
+            for (int j = 0; j < (int) LENGTH(nodes); j++) {
+                TEST_ASSERT_EQUAL_INT(i < j, List_is_before(list, nodes[i], nodes[j]));
+            }
+        }
+        TEST_ASSERT_FALSE(List_is_before(list, node1, NULL));
+        TEST_ASSERT_FALSE(List_is_before(list, NULL, node1));
+    }
+
+    List *other = List_new(free);
+    Node *node6 = List_add_tail(other, NULL);
+    TEST_ASSERT_FALSE(List_is_before(list, node1, node6));
+    List_free(other);
+
+    List_free(list);
+}
+
 void test_list_get_index() {
     List *list = List_new(free);
 
@@ -271,7 +407,7 @@ void test_list_get_index() {
 
     TEST_ASSERT_EQUAL_INT(-1, List_get_index(list, NULL));
 
-    Node node6;
+    Node node6 = { 0 };
     TEST_ASSERT_EQUAL_INT(-1, List_get_index(list, &node6));
 
     TEST_ASSERT_EQUAL_INT(0, List_get_index(list, node1));
@@ -458,6 +594,867 @@ void test_list_reverse() {
     List_reverse(list);
     TEST_ASSERT_EQUAL_LIST(list, nodes1, LENGTH(nodes1));
 
+    Node *node6 = List_add_tail(list, NULL);
+    List_reverse(list);
+    Node *nodes3[] = { node6, node5, node4, node3, node2, node1 };
+    TEST_ASSERT_EQUAL_LIST(list, nodes3, LENGTH(nodes3));
+
+    List_free(list);
+}
+
+void test_list_reverse_even() {
+    for (int indexed = 0; indexed < 2; indexed++) {
+        List *list = List_new(free);
+        if (indexed) {
+            List_index(list);
+        }
+
+        Node *node1 = List_add_tail(list, NULL);
+        Node *node2 = List_add_tail(list, NULL);
+        List_reverse(list);
+        Node *nodes1[] = { node2, node1 };
+        TEST_ASSERT_EQUAL_INDEX(list, nodes1, LENGTH(nodes1));
+
+        Node *node3 = List_add_tail(list, NULL);
+        Node *node4 = List_add_tail(list, NULL);
+        List_reverse(list);
+        Node *nodes2[] = { node4, node3, node1, node2 };
+        TEST_ASSERT_EQUAL_INDEX(list, nodes2, LENGTH(nodes2));
+
+        List_free(list);
+    }
+}
+
+void test_list_rotate() {
+    List *list = List_new(free);
+
+    List_rotate(list, 3);
+    TEST_ASSERT_NULL(list->head);
+
+    Node *node1 = List_add_tail(list, NULL);
+    Node *node2 = List_add_tail(list, NULL);
+    Node *node3 = List_add_tail(list, NULL);
+    Node *node4 = List_add_tail(list, NULL);
+    Node *node5 = List_add_tail(list, NULL);
+
+    for (int indexed = 0; indexed < 2; indexed++) {
+        if (indexed) {
+            List_index(list);
+        }
+
+        List_rotate(list, 2);
+        Node *nodes1[] = { node3, node4, node5, node1, node2 };
+        TEST_ASSERT_EQUAL_INDEX(list, nodes1, LENGTH(nodes1));
+
+        List_rotate(list, -1);
+        Node *nodes2[] = { node2, node3, node4, node5, node1 };
+        TEST_ASSERT_EQUAL_INDEX(list, nodes2, LENGTH(nodes2));
+
+        List_rotate(list, 8);
+        Node *nodes3[] = { node5, node1, node2, node3, node4 };
+        TEST_ASSERT_EQUAL_INDEX(list, nodes3, LENGTH(nodes3));
+
+        List_rotate(list, 5);
+        TEST_ASSERT_EQUAL_INDEX(list, nodes3, LENGTH(nodes3));
+
+        List_get_at(list, 1);
+        List_rotate(list, -4);
+        Node *nodes4[] = { node1, node2, node3, node4, node5 };
+        TEST_ASSERT_EQUAL_INDEX(list, nodes4, LENGTH(nodes4));
+        TEST_ASSERT_EQUAL_PTR(node5, List_get_at(list, 4));
+    }
+
+    List_free(list);
+}
+
+void test_list_splice() {
+    List *list1 = List_new(free);
+    List *list2 = List_new(free);
+
+    Node *node1 = List_add_tail(list1, NULL);
+    Node *node2 = List_add_tail(list1, NULL);
+    Node *node3 = List_add_tail(list1, NULL);
+    Node *node4 = List_add_tail(list2, NULL);
+    Node *node5 = List_add_tail(list2, NULL);
+    Node *node6 = List_add_tail(list2, NULL);
+    Node *node7 = List_add_tail(list2, NULL);
+
+    List_splice(list1, node2, list2, node5, node6);
+    Node *nodes1[] = { node1, node5, node6, node2, node3 };
+    TEST_ASSERT_EQUAL_INDEX(list1, nodes1, LENGTH(nodes1));
+    Node *nodes2[] = { node4, node7 };
+    TEST_ASSERT_EQUAL_INDEX(list2, nodes2, LENGTH(nodes2));
+    TEST_ASSERT_TRUE(List_contains(list1, node5));
+    TEST_ASSERT_FALSE(List_contains(list2, node6));
+
+    List_index(list2);
+    List_splice(list2, node4, list1, node1, node1);
+    List_splice(list2, NULL, list1, node3, node3);
+    Node *nodes3[] = { node5, node6, node2 };
+    TEST_ASSERT_EQUAL_INDEX(list1, nodes3, LENGTH(nodes3));
+    Node *nodes4[] = { node1, node4, node7, node3 };
+    TEST_ASSERT_EQUAL_INDEX(list2, nodes4, LENGTH(nodes4));
+
+    List_splice(list1, NULL, list2, node1, node3);
+    Node *nodes5[] = { node5, node6, node2, node1, node4, node7, node3 };
+    TEST_ASSERT_EQUAL_INDEX(list1, nodes5, LENGTH(nodes5));
+    TEST_ASSERT_NULL(list2->head);
+    TEST_ASSERT_NULL(list2->tail);
+    TEST_ASSERT_EQUAL_INT(0, list2->size);
+
+    TEST_ASSERT_TRUE(List_splice(list1, node5, list1, node4, node3));
+    Node *nodes6[] = { node4, node7, node3, node5, node6, node2, node1 };
+    TEST_ASSERT_EQUAL_INDEX(list1, nodes6, LENGTH(nodes6));
+
+    TEST_ASSERT_FALSE(List_splice(list1, node7, list1, node4, node3));
+    TEST_ASSERT_FALSE(List_splice(list1, node3, list1, node4, node3));
+    TEST_ASSERT_EQUAL_INDEX(list1, nodes6, LENGTH(nodes6));
+
+    List_free(list1);
+    List_free(list2);
+}
+
+void test_list_concat() {
+    List *list1 = List_new(free);
+    List *list2 = List_new(free);
+
+    TEST_ASSERT_TRUE(List_concat(list1, list2));
+    TEST_ASSERT_NULL(list1->head);
+
+    Node *node1 = List_add_tail(list2, NULL);
+    Node *node2 = List_add_tail(list2, NULL);
+    List_concat(list1, list2);
+    Node *nodes1[] = { node1, node2 };
+    TEST_ASSERT_EQUAL_INDEX(list1, nodes1, LENGTH(nodes1));
+    TEST_ASSERT_NULL(list2->head);
+
+    Node *node3 = List_add_tail(list2, NULL);
+    List_index(list1);
+    List_get_at(list1, 1);
+    List_concat(list1, list2);
+    TEST_ASSERT_EQUAL_PTR(node2, list1->current);
+    Node *nodes2[] = { node1, node2, node3 };
+    TEST_ASSERT_EQUAL_INDEX(list1, nodes2, LENGTH(nodes2));
+
+    List_free(list1);
+    List_free(list2);
+}
+
+void test_list_split_at() {
+    Pool *pool = Pool_new(sizeof(Node), 8);
+    List *list = List_new_pooled(free, pool);
+
+    TEST_ASSERT_NULL(List_split_at(list, 1));
+
+    Node *node1 = List_add_tail(list, NULL);
+    Node *node2 = List_add_tail(list, NULL);
+    Node *node3 = List_add_tail(list, NULL);
+    Node *node4 = List_add_tail(list, NULL);
+
+    TEST_ASSERT_NULL(List_split_at(list, -1));
+    TEST_ASSERT_NULL(List_split_at(list, 5));
+
+    List *empty = List_split_at(list, 4);
+    TEST_ASSERT_NULL(empty->head);
+    TEST_ASSERT_EQUAL_PTR(pool, empty->pool);
+    List_free(empty);
+
+    List_index(list);
+    List_get_at(list, 0);
+    List *other = List_split_at(list, 1);
+    Node *nodes1[] = { node1 };
+    TEST_ASSERT_EQUAL_INDEX(list, nodes1, LENGTH(nodes1));
+    Node *nodes2[] = { node2, node3, node4 };
+    TEST_ASSERT_EQUAL_INDEX(other, nodes2, LENGTH(nodes2));
+    TEST_ASSERT_TRUE(List_contains(other, node3));
+    TEST_ASSERT_EQUAL_INT(3, pool->refs);
+
+    List_free(other);
+    List_free(list);
+    TEST_ASSERT_EQUAL_INT(0, pool->used);
+    Pool_free(pool);
+}
+
+typedef struct {
+    int key;
+    int id;
+} Pair;
+
+static int compare_pairs(const void *a, const void *b) {
+    return ((const Pair *) a)->key - ((const Pair *) b)->key;
+}
+
+void TEST_ASSERT_SORTED_LIST(List *list, int size) {
+    TEST_ASSERT_EQUAL_INT(size, list->size);
+    Node *node = list->head;
+    TEST_ASSERT_NULL(node ? node->prev : NULL);
+    for (int i = 0; i < size; i++) {
+        TEST_ASSERT_TRUE(List_contains(list, node));
+        TEST_ASSERT_EQUAL_PTR(node, node->next ? node->next->prev : list->tail);
+        if (node->next) {
+            Pair *a = node->data;
+            Pair *b = node->next->data;
+            TEST_ASSERT_TRUE(a->key < b->key || (a->key == b->key && a->id < b->id));
+        }
+        node = node->next;
+    }
+    TEST_ASSERT_NULL(node);
+}
+
+void test_list_sort() {
+    Pair pairs[500];
+    List *list = List_new(NULL);
+
+    List_sort(list, compare_pairs);
+    TEST_ASSERT_NULL(list->head);
+
+    srand(3);
+    for (int i = 0; i < (int) LENGTH(pairs); i++) {
+        pairs[i].key = rand() % 50;
+        pairs[i].id = i;
+        List_add_tail(list, &pairs[i]);
+    }
+    List_sort(list, compare_pairs);
+    TEST_ASSERT_SORTED_LIST(list, LENGTH(pairs));
+
+    List_sort(list, compare_pairs);
+    TEST_ASSERT_SORTED_LIST(list, LENGTH(pairs));
+
+    List_clear(list);
+    for (int i = 0; i < (int) LENGTH(pairs); i++) {
+        pairs[i].key = LENGTH(pairs) - i / 2;
+        List_add_tail(list, &pairs[i]);
+    }
+    List_index(list);
+    List_sort(list, compare_pairs);
+    TEST_ASSERT_SORTED_LIST(list, LENGTH(pairs));
+    for (int i = 0; i < (int) LENGTH(pairs); i++) {
+        Node *node = List_get_at(list, i);
+        TEST_ASSERT_EQUAL_INT(i, List_get_index(list, node));
+    }
+
+    List_free(list);
+}
+
+void test_list_merge_sorted() {
+    Pair pairs[300];
+    List *list = List_new(NULL);
+    List *others[3];
+
+    for (int i = 0; i < 3; i++) {
+        others[i] = List_new(NULL);
+    }
+    List_index(others[1]);
+    for (int i = 0; i < (int) LENGTH(pairs); i++) {
+        pairs[i].key = i / 4;
+        pairs[i].id = i;
+        List_add_tail(i % 4 ? others[i % 4 - 1] : list, &pairs[i]);
+    }
+
+    List_merge_sorted(list, others, 3, compare_pairs);
+    TEST_ASSERT_SORTED_LIST(list, LENGTH(pairs));
+    for (int i = 0; i < 3; i++) {
+        TEST_ASSERT_NULL(others[i]->head);
+        TEST_ASSERT_NULL(others[i]->tail);
+        TEST_ASSERT_EQUAL_INT(0, others[i]->size);
+        List_free(others[i]);
+    }
+
+    List_free(list);
+}
+
+void test_list_move_alloc() {
+    Pair pairs[12];
+    for (int i = 0; i < (int) LENGTH(pairs); i++) {
+        pairs[i].key = i;
+        pairs[i].id = i;
+    }
+    Pool *pool = Pool_new(sizeof(Node), 4);
+    List *list = List_new(NULL);
+    List *cached = List_new_cached(NULL);
+    List *pooled = List_new_pooled(NULL, pool);
+    List *others[] = { pooled };
+
+    for (int i = 0; i < 4; i++) {
+        List_add_tail(list, &pairs[i]);
+        List_add_tail(cached, &pairs[i + 4]);
+    }
+    List_index(cached);
+    List_get_at(cached, 2);
+    List_concat(list, cached);
+    List_free(cached);
+    TEST_ASSERT_SORTED_LIST(list, 8);
+    TEST_ASSERT_NULL(list->ranks);
+
+    for (int i = 0; i < 4; i++) {
+        List_add_tail(pooled, &pairs[8 + i]);
+    }
+    List_merge_sorted(list, others, 1, compare_pairs);
+    TEST_ASSERT_EQUAL_INT(0, pool->used);
+    TEST_ASSERT_SORTED_LIST(list, 12);
+
+    List *split = List_split_at(list, 6);
+    TEST_ASSERT_FALSE(split->cached);
+    TEST_ASSERT_NULL(split->pool);
+    List_splice(pooled, NULL, split, split->head, split->tail);
+    List_free(split);
+    TEST_ASSERT_EQUAL_INT(6, pool->used);
+    List_concat(list, pooled);
+    TEST_ASSERT_EQUAL_INT(0, pool->used);
+    TEST_ASSERT_SORTED_LIST(list, 12);
+
+    List *owning = List_new(free);
+    List_add_tail(owning, malloc(1));
+    TEST_ASSERT_FALSE(List_concat(list, owning));
+    TEST_ASSERT_FALSE(List_splice(owning, NULL, list, list->head, list->head));
+    List *mismatched[] = { owning };
+    List_merge_sorted(list, mismatched, 1, compare_pairs);
+    TEST_ASSERT_EQUAL_INT(1, owning->size);
+    TEST_ASSERT_SORTED_LIST(list, 12);
+
+    List_free(owning);
+    List_free(pooled);
+    Pool_free(pool);
+    List_free(list);
+}
+
+void TEST_ASSERT_EQUAL_VIEW(List *list, Node *nodes[], int size) {
+    Node *forward = List_first(list);
+    Node *backward = List_last(list);
+    for (int i = 0; i < size; i++) {
+        TEST_ASSERT_EQUAL_PTR(nodes[i], forward);
+        TEST_ASSERT_EQUAL_PTR(nodes[size-i-1], backward);
+        TEST_ASSERT_EQUAL_PTR(nodes[i], List_get_at(list, i));
+        TEST_ASSERT_EQUAL_INT(i, List_get_index(list, nodes[i]));
+        forward = List_next(list, forward);
+        backward = List_prev(list, backward);
+    }
+    TEST_ASSERT_NULL(forward);
+    TEST_ASSERT_NULL(backward);
+    TEST_ASSERT_NULL(List_get_at(list, -1));
+    TEST_ASSERT_NULL(List_get_at(list, size));
+}
+
+void test_list_reverse_cursor() {
+    List *list = List_new(free);
+
+    Node *node1 = List_add_tail(list, NULL);
+    List_add_tail(list, NULL);
+    List_add_tail(list, NULL);
+    Node *node4 = List_add_tail(list, NULL);
+
+    List_get_at(list, 0);
+    List_reverse(list);
+    TEST_ASSERT_EQUAL_PTR(node1, list->current);
+    TEST_ASSERT_EQUAL_INT(3, list->position);
+    TEST_ASSERT_EQUAL_PTR(node4, List_get_at(list, 0));
+
+    List_free(list);
+}
+
+void test_list_flip() {
+    List *list = List_new(free);
+
+    List_flip(list);
+    TEST_ASSERT_NULL(List_first(list));
+    TEST_ASSERT_NULL(List_last(list));
+    List_flip(list);
+
+    Node *node1 = List_add_tail(list, NULL);
+    Node *node2 = List_add_tail(list, NULL);
+    Node *node3 = List_add_tail(list, NULL);
+    Node *node4 = List_add_tail(list, NULL);
+
+    for (int indexed = 0; indexed < 2; indexed++) {
+        if (indexed) {
+            List_index(list);
+        }
+
+        List_flip(list);
+        TEST_ASSERT_TRUE(list->reversed);
+        Node *nodes1[] = { node4, node3, node2, node1 };
+        TEST_ASSERT_EQUAL_VIEW(list, nodes1, LENGTH(nodes1));
+        Node *physical[] = { node1, node2, node3, node4 };
+        TEST_ASSERT_EQUAL_LIST(list, physical, LENGTH(physical));
+        TEST_ASSERT_TRUE(List_is_before(list, node3, node1));
+        TEST_ASSERT_FALSE(List_is_before(list, node1, node3));
+
+        Node *node5 = List_add_at(list, 1, NULL);
+        Node *nodes2[] = { node4, node5, node3, node2, node1 };
+        TEST_ASSERT_EQUAL_VIEW(list, nodes2, LENGTH(nodes2));
+
+        List_delete_at(list, 1);
+        TEST_ASSERT_EQUAL_VIEW(list, nodes1, LENGTH(nodes1));
+
+        List_shift_left(list);
+        Node *nodes3[] = { node3, node2, node1, node4 };
+        TEST_ASSERT_EQUAL_VIEW(list, nodes3, LENGTH(nodes3));
+
+        List_shift_right(list);
+        TEST_ASSERT_EQUAL_VIEW(list, nodes1, LENGTH(nodes1));
+
+        List_flip(list);
+        TEST_ASSERT_FALSE(list->reversed);
+        TEST_ASSERT_EQUAL_VIEW(list, physical, LENGTH(physical));
+    }
+
+    List_flip(list);
+    List *other = List_new(free);
+    List_concat(other, list);
+    TEST_ASSERT_FALSE(list->reversed);
+    Node *nodes4[] = { node4, node3, node2, node1 };
+    TEST_ASSERT_EQUAL_LIST(other, nodes4, LENGTH(nodes4));
+    TEST_ASSERT_EQUAL_VIEW(other, nodes4, LENGTH(nodes4));
+
+    List_free(other);
+    List_free(list);
+}
+
+void test_list_flip_add() {
+    for (int indexed = 0; indexed < 2; indexed++) {
+        List *list = List_new(NULL);
+        void *data[] = { NULL, NULL };
+        if (indexed) {
+            List_index(list);
+        }
+
+        Node *node1 = List_add_tail(list, NULL);
+        Node *node2 = List_add_tail(list, NULL);
+        Node *node3 = List_add_tail(list, NULL);
+        List_flip(list);
+
+        Node *node4 = List_add_head(list, NULL);
+        Node *node5 = List_add_tail(list, NULL);
+        Node *nodes1[] = { node4, node3, node2, node1, node5 };
+        TEST_ASSERT_EQUAL_VIEW(list, nodes1, LENGTH(nodes1));
+
+        Node *node6 = List_add_before(list, List_first(list), NULL);
+        Node *node7 = List_add_after(list, List_last(list), NULL);
+        Node *node8 = List_add_before(list, node2, NULL);
+        Node *node9 = List_add_after(list, node2, NULL);
+        Node *nodes2[] = { node6, node4, node3, node8, node2, node9, node1, node5, node7 };
+        TEST_ASSERT_EQUAL_VIEW(list, nodes2, LENGTH(nodes2));
+
+        Node *node10 = List_add_at(list, 1, NULL);
+        Node *node11 = List_add_tail_many(list, data, LENGTH(data));
+        Node *node12 = List_add_after_many(list, NULL, data, LENGTH(data));
+        Node *node13 = List_add_after_many(list, node3, data, LENGTH(data));
+        Node *nodes3[] = {
+            node12, List_next(list, node12), node6, node10, node4, node3, node13,
+            List_next(list, node13), node8, node2, node9, node1, node5, node7,
+            node11, List_next(list, node11)
+        };
+        TEST_ASSERT_EQUAL_VIEW(list, nodes3, LENGTH(nodes3));
+        TEST_ASSERT_EQUAL_PTR(node11, List_get_at(list, 14));
+        TEST_ASSERT_EQUAL_PTR(node12, List_first(list));
+
+        List_flip(list);
+        Node *node14 = List_add_head(list, NULL);
+        TEST_ASSERT_EQUAL_PTR(node14, list->head);
+
+        List_free(list);
+    }
+}
+
+void test_list_flip_sort() {
+    Pair pairs[] = { { 1, 0 }, { 1, 1 }, { 0, 2 }, { 2, 3 }, { 1, 4 } };
+    List *list = List_new(NULL);
+
+    for (int i = 0; i < (int) LENGTH(pairs); i++) {
+        List_add_tail(list, &pairs[i]);
+    }
+    List_flip(list);
+    List_sort(list, compare_pairs);
+    TEST_ASSERT_FALSE(list->reversed);
+    int order[] = { 2, 4, 1, 0, 3 };
+    for (int i = 0; i < (int) LENGTH(order); i++) {
+        TEST_ASSERT_EQUAL_PTR(&pairs[order[i]], List_get_at(list, i)->data);
+    }
+
+    List_free(list);
+}
+
+void test_list_iter() {
+    List *list = List_new(NULL);
+    Node *nodes[LIST_AHEAD * 3];
+    ListIter iter;
+
+    List_iter(&iter, list, LIST_FORWARD);
+    TEST_ASSERT_NULL(List_iter_next(&iter));
+
+    for (int i = 0; i < (int) LENGTH(nodes); i++) {
+        nodes[i] = List_add_tail(list, NULL);
+    }
+    List_iter(&iter, list, LIST_FORWARD | LIST_PREFETCH_DATA);
+    for (int i = 0; i < (int) LENGTH(nodes); i++) {
+        TEST_ASSERT_EQUAL_PTR(nodes[i], List_iter_next(&iter));
+    }
+    TEST_ASSERT_NULL(List_iter_next(&iter));
+
+    List_iter(&iter, list, LIST_BACKWARD);
+    for (int i = LENGTH(nodes) - 1; i >= 0; i--) {
+        TEST_ASSERT_EQUAL_PTR(nodes[i], List_iter_next(&iter));
+    }
+    TEST_ASSERT_NULL(List_iter_next(&iter));
+
+    List_flip(list);
+    List_iter(&iter, list, LIST_FORWARD);
+    TEST_ASSERT_EQUAL_PTR(nodes[LENGTH(nodes) - 1], List_iter_next(&iter));
+    List_iter(&iter, list, LIST_BACKWARD);
+    TEST_ASSERT_EQUAL_PTR(nodes[0], List_iter_next(&iter));
+
+    List_free(list);
+}
+
+void test_list_iter_delete() {
+    List *list = List_new(NULL);
+    for (int i = 0; i < 20; i++) {
+        List_add_tail(list, NULL);
+    }
+
+    ListIter iter;
+    List_iter(&iter, list, LIST_FORWARD);
+    Node *node;
+    while ((node = List_iter_next(&iter))) {
+        List_delete(list, node);
+    }
+    TEST_ASSERT_EQUAL_INT(0, list->size);
+
+    List_free(list);
+}
+
+static void append_int(void *data, void *arg) {
+    int *out = arg;
+    out[out[0]++ + 1] = *(int *) data;
+}
+
+void test_list_foreach() {
+    List *list = List_new(NULL);
+    int values[] = { 1, 2, 3, 4, 5 };
+    int out[LENGTH(values) + 1] = { 0 };
+
+    for (int i = 0; i < (int) LENGTH(values); i++) {
+        List_add_tail(list, &values[i]);
+    }
+    List_foreach(list, append_int, out, LIST_PREFETCH_DATA);
+    TEST_ASSERT_EQUAL_INT(5, out[0]);
+    TEST_ASSERT_EQUAL_INT_ARRAY(values, out + 1, LENGTH(values));
+
+    int reversed[] = { 5, 4, 3, 2, 1 };
+    out[0] = 0;
+    List_foreach(list, append_int, out, LIST_BACKWARD);
+    TEST_ASSERT_EQUAL_INT_ARRAY(reversed, out + 1, LENGTH(values));
+
+    List_free(list);
+}
+
+typedef struct {
+    Node *old[8];
+    Node *node[8];
+    int count;
+} Moves;
+
+static void record_move(Node *old, Node *node, void *arg) {
+    Moves *moves = arg;
+    moves->old[moves->count] = old;
+    moves->node[moves->count++] = node;
+}
+
+void test_list_compact() {
+    List *list = List_new(free);
+    int *values[5];
+    Node *nodes[5];
+    for (int i = 0; i < 5; i++) {
+        values[i] = malloc(sizeof(int));
+        nodes[i] = List_add_tail(list, values[i]);
+    }
+    List_index(list);
+    List_get_at(list, 3);
+
+    Moves moves = { 0 };
+    List_compact(list, record_move, &moves);
+    TEST_ASSERT_NOT_NULL(list->pool);
+    TEST_ASSERT_EQUAL_INT(5, moves.count);
+    for (int i = 0; i < 5; i++) {
+        TEST_ASSERT_EQUAL_PTR(nodes[i], moves.old[i]);
+        TEST_ASSERT_EQUAL_PTR(moves.node[0] + i, moves.node[i]);
+        nodes[i] = moves.node[i];
+    }
+    TEST_ASSERT_EQUAL_LIST(list, nodes, LENGTH(nodes));
+    TEST_ASSERT_EQUAL_PTR(nodes[3], list->current);
+    for (int i = 0; i < 5; i++) {
+        TEST_ASSERT_EQUAL_PTR(values[i], nodes[i]->data);
+        TEST_ASSERT_EQUAL_INT(i, List_get_index(list, nodes[i]));
+    }
+
+    List_delete(list, nodes[2]);
+    List_free(list);
+}
+
+void test_list_compact_range() {
+    Pool *pool = Pool_new(sizeof(Node), 2);
+    List *list = List_new_pooled(NULL, pool);
+    Pool_free(pool);
+    Node *nodes[7];
+    for (int i = 0; i < 7; i++) {
+        nodes[i] = List_add_head(list, NULL);
+    }
+    List_delete(list, nodes[3]);
+    Node *order[] = { nodes[6], nodes[5], nodes[4], nodes[2], nodes[1], nodes[0] };
+    TEST_ASSERT_EQUAL_LIST(list, order, LENGTH(order));
+
+    Moves moves = { 0 };
+    Node *next = list->head;
+    int steps = 0;
+    while ((next = List_compact_range(list, next, 4, record_move, &moves))) {
+        steps++;
+    }
+    TEST_ASSERT_EQUAL_INT(1, steps);
+    TEST_ASSERT_EQUAL_INT(6, moves.count);
+    for (int i = 0; i < 6; i++) {
+        TEST_ASSERT_EQUAL_PTR(order[i], moves.old[i]);
+        TEST_ASSERT_EQUAL_PTR(moves.node[i < 4 ? 0 : 4] + i % 4, moves.node[i]);
+    }
+    TEST_ASSERT_EQUAL_LIST(list, moves.node, 6);
+    TEST_ASSERT_EQUAL_INT(6, list->pool->used);
+
+    List_free(list);
+}
+
+static size_t pool_capacity(Pool *pool) {
+    size_t capacity = 0;
+    for (Chunk *chunk = pool->chunks; chunk; chunk = chunk->next) {
+        capacity += chunk->count;
+    }
+    return capacity;
+}
+
+void test_list_compact_memory() {
+    Pool *pool = Pool_new(sizeof(Node), 64);
+    List *owner = List_new_pooled(NULL, pool);
+    List *shared = List_new_pooled(NULL, pool);
+    Pool_free(pool);
+    for (int i = 0; i < 1000; i++) {
+        List_add_tail(owner, NULL);
+        List_add_tail(shared, NULL);
+    }
+    List_free(shared);
+
+    List_compact(owner, NULL, NULL);
+    TEST_ASSERT_TRUE(owner->pool != pool);
+    for (int i = 0; i < 10; i++) {
+        List_compact(owner, NULL, NULL);
+    }
+    TEST_ASSERT_EQUAL_INT(1000, pool_capacity(owner->pool));
+    TEST_ASSERT_EQUAL_INT(1, owner->pool->refs);
+
+    pool = Pool_retain(owner->pool);
+    for (int i = 0; i < 10; i++) {
+        List_compact(owner, NULL, NULL);
+        Node *next = owner->head;
+        while ((next = List_compact_range(owner, next, 64, NULL, NULL)));
+    }
+    TEST_ASSERT_EQUAL_PTR(pool, owner->pool);
+    TEST_ASSERT_TRUE(pool_capacity(pool) <= 1000 + 64);
+    TEST_ASSERT_EQUAL_INT(1000, pool->used);
+    TEST_ASSERT_EQUAL_INT(1000, owner->size);
+
+    List_free(owner);
+    Pool_free(pool);
+}
+
+void test_list_from_array() {
+    int values[] = { 1, 2, 3, 4 };
+    void *data[] = { &values[0], &values[1], &values[2], &values[3] };
+
+    List *plain = List_from_array(data, LENGTH(data), NULL, NULL);
+    TEST_ASSERT_NULL(plain->pool);
+    TEST_ASSERT_EQUAL_INT(4, plain->size);
+
+    Pool *pool = Pool_new(sizeof(Node), 2);
+    List *list = List_from_array(data, LENGTH(data), NULL, pool);
+    TEST_ASSERT_EQUAL_PTR(pool, list->pool);
+    TEST_ASSERT_EQUAL_INT(4, pool->used);
+    TEST_ASSERT_EQUAL_INT(4, list->size);
+    Node *node = list->head;
+    for (int i = 0; i < (int) LENGTH(data); i++, node = node->next) {
+        TEST_ASSERT_EQUAL_PTR(list->head + i, node);
+        TEST_ASSERT_EQUAL_PTR(data[i], node->data);
+        TEST_ASSERT_EQUAL_PTR(list, node->list);
+    }
+    Node *nodes[] = { list->head, list->head + 1, list->head + 2, list->head + 3 };
+    TEST_ASSERT_EQUAL_LIST(list, nodes, LENGTH(nodes));
+
+    void *out[LENGTH(data)];
+    TEST_ASSERT_EQUAL_INT(4, List_to_array(list, out));
+    TEST_ASSERT_EQUAL_PTR_ARRAY(data, out, LENGTH(data));
+    List_flip(list);
+    List_to_array(list, out);
+    TEST_ASSERT_EQUAL_PTR(data[3], out[0]);
+    TEST_ASSERT_EQUAL_PTR(data[0], out[3]);
+
+    List *other = List_from_array(data, LENGTH(data), NULL, pool);
+    List_concat(plain, other);
+    List_free(other);
+    TEST_ASSERT_EQUAL_INT(4, pool->used);
+    void *all[2 * LENGTH(data)];
+    TEST_ASSERT_EQUAL_INT(8, List_to_array(plain, all));
+    TEST_ASSERT_EQUAL_PTR_ARRAY(data, all, LENGTH(data));
+    TEST_ASSERT_EQUAL_PTR_ARRAY(data, all + LENGTH(data), LENGTH(data));
+
+    List_free(list);
+    Pool_free(pool);
+    List_free(plain);
+}
+
+void test_list_add_many() {
+    List *list = List_new(NULL);
+    int values[6];
+    void *data[] = { &values[0], &values[1], &values[2], &values[3], &values[4], &values[5] };
+
+    TEST_ASSERT_NULL(List_add_tail_many(list, data, 0));
+    Node *node1 = List_add_tail_many(list, data, 2);
+    Node *node2 = node1->next;
+    List_index(list);
+
+    Node *node3 = List_add_after_many(list, node1, data + 2, 2);
+    Node *node4 = node3->next;
+    Node *node5 = List_add_after_many(list, NULL, data + 4, 2);
+    Node *node6 = node5->next;
+    Node *nodes[] = { node5, node6, node1, node3, node4, node2 };
+    TEST_ASSERT_EQUAL_LIST(list, nodes, LENGTH(nodes));
+    for (int i = 0; i < (int) LENGTH(nodes); i++) {
+        TEST_ASSERT_EQUAL_INT(i, List_get_index(list, nodes[i]));
+        TEST_ASSERT_EQUAL_PTR(nodes[i], List_get_at(list, i));
+    }
+    TEST_ASSERT_EQUAL_PTR(data[4], node5->data);
+    TEST_ASSERT_EQUAL_PTR(data[3], node4->data);
+
+    List_unindex(list);
+    List_get_at(list, 2);
+    List_add_after_many(list, NULL, data, 1);
+    TEST_ASSERT_EQUAL_PTR(node1, list->current);
+    TEST_ASSERT_EQUAL_INT(3, list->position);
+    TEST_ASSERT_EQUAL_PTR(node1, List_get_at(list, 3));
+
+    List_free(list);
+}
+
+static int is_even(void *data, void *arg) {
+    (void) arg;
+    return *(int *) data % 2 == 0;
+}
+
+static size_t hash_int(const void *data) {
+    return (size_t) *(const int *) data * 0x9e3779b97f4a7c15ULL;
+}
+
+static int compare_ints(const void *a, const void *b) {
+    return *(const int *) a - *(const int *) b;
+}
+
+static List *int_list(int values[], int size) {
+    List *list = List_new(free);
+    for (int i = 0; i < size; i++) {
+        int *value = malloc(sizeof(int));
+        *value = values[i];
+        List_add_tail(list, value);
+    }
+    return list;
+}
+
+void TEST_ASSERT_EQUAL_INTS(List *list, int values[], int size) {
+    TEST_ASSERT_EQUAL_INT(size, list->size);
+    Node *node = List_first(list);
+    for (int i = 0; i < size; i++, node = List_next(list, node)) {
+        TEST_ASSERT_EQUAL_INT(values[i], *(int *) node->data);
+    }
+    TEST_ASSERT_NULL(node);
+}
+
+void test_list_flip_add_many() {
+    int values[] = { 1, 2, 3, 4, 5 };
+    void *data[] = { &values[2], &values[3] };
+    List *list = List_new(NULL);
+
+    List_add_tail(list, &values[1]);
+    List_add_tail(list, &values[0]);
+    List_flip(list);
+    Node *node = List_add_tail_many(list, data, LENGTH(data));
+    TEST_ASSERT_EQUAL_PTR(&values[2], node->data);
+    List_add_tail(list, &values[4]);
+
+    int expected[] = { 1, 2, 3, 4, 5 };
+    TEST_ASSERT_EQUAL_INTS(list, expected, LENGTH(expected));
+    void *array[5];
+    List_to_array(list, array);
+    for (int i = 0; i < 5; i++) {
+        TEST_ASSERT_EQUAL_PTR(&values[i], array[i]);
+    }
+
+    List_free(list);
+}
+
+void test_list_delete_if() {
+    int values[] = { 1, 2, 3, 4, 6, 7, 8 };
+    List *list = int_list(values, LENGTH(values));
+    List_index(list);
+
+    TEST_ASSERT_EQUAL_INT(4, List_delete_if(list, is_even, NULL));
+    int odd[] = { 1, 3, 7 };
+    TEST_ASSERT_EQUAL_INTS(list, odd, LENGTH(odd));
+    for (int i = 0; i < (int) LENGTH(odd); i++) {
+        TEST_ASSERT_EQUAL_INT(i, List_get_index(list, List_get_at(list, i)));
+    }
+    TEST_ASSERT_EQUAL_INT(0, List_delete_if(list, is_even, NULL));
+
+    List_free(list);
+}
+
+void test_list_filter() {
+    int values[] = { 1, 2, 3, 4, 6, 7, 8 };
+    List *list = int_list(values, LENGTH(values));
+    List_get_at(list, 4);
+
+    TEST_ASSERT_EQUAL_INT(3, List_filter(list, is_even, NULL));
+    int even[] = { 2, 4, 6, 8 };
+    TEST_ASSERT_EQUAL_INTS(list, even, LENGTH(even));
+    for (int i = 0; i < (int) LENGTH(even); i++) {
+        TEST_ASSERT_EQUAL_INT(even[i], *(int *) List_get_at(list, i)->data);
+    }
+
+    TEST_ASSERT_EQUAL_INT(0, List_filter(list, is_even, NULL));
+    TEST_ASSERT_EQUAL_INT(4, List_delete_if(list, is_even, NULL));
+    TEST_ASSERT_NULL(list->head);
+    TEST_ASSERT_NULL(list->tail);
+
+    List_free(list);
+}
+
+void test_list_unique() {
+    int values[] = { 3, 1, 3, 2, 1, 1, 4, 2, 3 };
+    List *list = int_list(values, LENGTH(values));
+
+    TEST_ASSERT_EQUAL_INT(5, List_unique(list, hash_int, compare_ints));
+    int unique[] = { 3, 1, 2, 4 };
+    TEST_ASSERT_EQUAL_INTS(list, unique, LENGTH(unique));
+
+    List_add_tail(list, NULL);
+    List_add_tail(list, NULL);
+    TEST_ASSERT_EQUAL_INT(0, List_unique(list, hash_int, compare_ints));
+    List_delete(list, list->tail);
+    List_delete(list, list->tail);
+    List_free(list);
+
+    list = int_list(values, LENGTH(values));
+    List_flip(list);
+    List_unique(list, hash_int, compare_ints);
+    int flipped[] = { 3, 2, 4, 1 };
+    TEST_ASSERT_EQUAL_INTS(list, flipped, LENGTH(flipped));
+    List_free(list);
+
+    list = List_new(NULL);
+    TEST_ASSERT_EQUAL_INT(0, List_unique(list, hash_int, compare_ints));
     List_free(list);
 }
 
@@ -479,6 +1476,57 @@ void test_list_clear() {
     List_free(list);
 }
 
+void test_list_clear_pooled() {
+    Pool *pool = Pool_new(sizeof(Node), 2);
+    List *list1 = List_new_pooled(free, pool);
+    List *list2 = List_new_pooled(NULL, pool);
+
+    for (int i = 0; i < 5; i++) {
+        List_add_tail(list1, malloc(1));
+        List_add_tail(list2, NULL);
+    }
+    TEST_ASSERT_EQUAL_INT(10, pool->used);
+
+    List_clear(list1);
+    TEST_ASSERT_NULL(list1->head);
+    TEST_ASSERT_NULL(list1->tail);
+    TEST_ASSERT_EQUAL_INT(0, list1->size);
+    TEST_ASSERT_EQUAL_INT(5, pool->used);
+    TEST_ASSERT_NOT_NULL(pool->chunks);
+
+    List_clear(list2);
+    TEST_ASSERT_NULL(list2->head);
+    TEST_ASSERT_NULL(list2->tail);
+    TEST_ASSERT_EQUAL_INT(0, list2->size);
+    TEST_ASSERT_EQUAL_INT(0, pool->used);
+    TEST_ASSERT_NULL(pool->chunks);
+
+    Node *node1 = List_add_tail(list1, malloc(1));
+    Node *nodes1[] = { node1 };
+    TEST_ASSERT_EQUAL_LIST(list1, nodes1, LENGTH(nodes1));
+
+    List_free(list1);
+    List_free(list2);
+    Pool_free(pool);
+}
+
+void test_list_clear_without_free() {
+    int values[] = { 1, 2, 3 };
+    List *list = List_new(NULL);
+
+    for (int i = 0; i < (int) LENGTH(values); i++) {
+        List_add_tail(list, &values[i]);
+    }
+    List_delete(list, list->head);
+    TEST_ASSERT_EQUAL_INT(2, list->size);
+
+    List_clear(list);
+    TEST_ASSERT_NULL(list->head);
+    TEST_ASSERT_EQUAL_INT(0, list->size);
+
+    List_free(list);
+}
+
 void test_list_delete() {
     List *list = List_new(free);
 
@@ -531,10 +1579,248 @@ void test_list_delete_at() {
     List_free(list);
 }
 
+void test_list_index() {
+    List *list = List_new(free);
+
+    Node *node1 = List_add_tail(list, NULL);
+    Node *node2 = List_add_tail(list, NULL);
+    Node *node3 = List_add_tail(list, NULL);
+
+    List_index(list);
+    TEST_ASSERT_TRUE(list->indexed);
+    Node *nodes1[] = { node1, node2, node3 };
+    TEST_ASSERT_EQUAL_INDEX(list, nodes1, LENGTH(nodes1));
+
+    Node *node4 = List_add_at(list, 1, NULL);
+    Node *node5 = List_add_head(list, NULL);
+    Node *node6 = List_add_after(list, node3, NULL);
+    Node *nodes2[] = { node5, node1, node4, node2, node3, node6 };
+    TEST_ASSERT_EQUAL_INDEX(list, nodes2, LENGTH(nodes2));
+
+    List_swap(list, node5, node3);
+    List_swap(list, node1, node4);
+    Node *nodes3[] = { node3, node4, node1, node2, node5, node6 };
+    TEST_ASSERT_EQUAL_INDEX(list, nodes3, LENGTH(nodes3));
+
+    List_shift_left(list);
+    Node *nodes4[] = { node4, node1, node2, node5, node6, node3 };
+    TEST_ASSERT_EQUAL_INDEX(list, nodes4, LENGTH(nodes4));
+
+    List_shift_right(list);
+    List_shift_right(list);
+    Node *nodes5[] = { node6, node3, node4, node1, node2, node5 };
+    TEST_ASSERT_EQUAL_INDEX(list, nodes5, LENGTH(nodes5));
+
+    List_reverse(list);
+    Node *nodes6[] = { node5, node2, node1, node4, node3, node6 };
+    TEST_ASSERT_EQUAL_INDEX(list, nodes6, LENGTH(nodes6));
+
+    List_delete_at(list, 2);
+    List_delete(list, node6);
+    Node *nodes7[] = { node5, node2, node4, node3 };
+    TEST_ASSERT_EQUAL_INDEX(list, nodes7, LENGTH(nodes7));
+
+    List *other = List_new(free);
+    List_index(other);
+    Node *node7 = List_add_tail(other, NULL);
+    TEST_ASSERT_EQUAL_INT(-1, List_get_index(list, node7));
+    TEST_ASSERT_EQUAL_INT(-1, List_get_index(list, NULL));
+    TEST_ASSERT_FALSE(List_contains(list, node7));
+    List_free(other);
+
+    List_unindex(list);
+    TEST_ASSERT_FALSE(list->indexed);
+    TEST_ASSERT_EQUAL_INDEX(list, nodes7, LENGTH(nodes7));
+
+    List_index(list);
+    List_clear(list);
+    TEST_ASSERT_NULL(list->ranks);
+    Node *node8 = List_add_tail(list, NULL);
+    Node *nodes8[] = { node8 };
+    TEST_ASSERT_EQUAL_INDEX(list, nodes8, LENGTH(nodes8));
+
+    List_free(list);
+}
+
+void test_list_index_random() {
+    Pool *pool = Pool_new(sizeof(Node), 64);
+    List *list = List_new_pooled(NULL, pool);
+    Node *nodes[300];
+    int size = 0;
+
+    List_index(list);
+    srand(1);
+    for (int step = 0; step < 3000; step++) {
+        int index = size ? rand() % size : 0;
+        if (size == (int) LENGTH(nodes) || (size && rand() % 3 == 0)) {
+            List_delete_at(list, index);
+            memmove(nodes + index, nodes + index + 1, (size - index - 1) * sizeof(Node *));
+            size--;
+        } else if (size > 1 && rand() % 2) {
+            int other = (index + 1 + rand() % (size - 1)) % size;
+            List_swap(list, nodes[index], nodes[other]);
+            Node *temp = nodes[index];
+            nodes[index] = nodes[other];
+            nodes[other] = temp;
+        } else {
+            Node *node = size ? List_add_at(list, index, NULL) : List_add_head(list, NULL);
+            memmove(nodes + index + 1, nodes + index, (size - index) * sizeof(Node *));
+            nodes[index] = node;
+            size++;
+        }
+    }
+    TEST_ASSERT_EQUAL_INDEX(list, nodes, size);
+
+    List_free(list);
+    Pool_free(pool);
+}
+
+void test_list_cursor() {
+    List *list = List_new(free);
+
+    Node *node1 = List_add_tail(list, NULL);
+    Node *node2 = List_add_tail(list, NULL);
+    Node *node3 = List_add_tail(list, NULL);
+    Node *node4 = List_add_tail(list, NULL);
+    Node *node5 = List_add_tail(list, NULL);
+
+    TEST_ASSERT_EQUAL_PTR(node2, List_get_at(list, 1));
+    TEST_ASSERT_EQUAL_PTR(node2, list->current);
+    TEST_ASSERT_EQUAL_INT(1, list->position);
+
+    TEST_ASSERT_EQUAL_PTR(node3, List_get_at(list, 2));
+    TEST_ASSERT_EQUAL_PTR(node3, list->current);
+    TEST_ASSERT_EQUAL_INT(2, list->position);
+
+    Node *node6 = List_add_head(list, NULL);
+    TEST_ASSERT_EQUAL_PTR(node3, list->current);
+    TEST_ASSERT_EQUAL_INT(3, list->position);
+
+    List_add_tail(list, NULL);
+    List_add_after(list, node3, NULL);
+    TEST_ASSERT_EQUAL_PTR(node3, list->current);
+    TEST_ASSERT_EQUAL_INT(3, list->position);
+
+    List_add_before(list, node3, NULL);
+    TEST_ASSERT_EQUAL_PTR(node3, list->current);
+    TEST_ASSERT_EQUAL_INT(4, list->position);
+
+    List_delete(list, node6);
+    TEST_ASSERT_EQUAL_PTR(node3, list->current);
+    TEST_ASSERT_EQUAL_INT(3, list->position);
+
+    List_delete(list, node3);
+    TEST_ASSERT_NOT_NULL(list->current);
+    TEST_ASSERT_EQUAL_PTR(list->current, List_get_at(list, 3));
+
+    List_add_after(list, node1, NULL);
+    TEST_ASSERT_NULL(list->current);
+
+    TEST_ASSERT_EQUAL_INT(2, List_get_index(list, node2));
+    TEST_ASSERT_EQUAL_PTR(node2, list->current);
+    List_swap(list, node2, node5);
+    TEST_ASSERT_EQUAL_PTR(node5, list->current);
+    TEST_ASSERT_EQUAL_INT(List_get_index(list, node5), list->position);
+
+    List_delete(list, node4);
+    TEST_ASSERT_NULL(list->current);
+
+    List_get_at(list, 0);
+    List_clear(list);
+    TEST_ASSERT_NULL(list->current);
+
+    List_free(list);
+}
+
+void test_list_cursor_drift() {
+    List *list = List_new(NULL);
+    void *data[] = { NULL, NULL };
+
+    for (int i = 0; i < 1000; i++) {
+        List_add_tail(list, NULL);
+        List_add_head(list, NULL);
+        List_add_after_many(list, NULL, data, LENGTH(data));
+        while (list->head) {
+            List_delete(list, list->head);
+        }
+    }
+    TEST_ASSERT_NULL(list->current);
+    TEST_ASSERT_EQUAL_INT(0, list->position);
+
+    List_add_tail(list, NULL);
+    Node *node = List_add_tail(list, NULL);
+    List_add_tail(list, NULL);
+    TEST_ASSERT_EQUAL_PTR(node, List_get_at(list, 1));
+    List_add_head(list, NULL);
+    TEST_ASSERT_EQUAL_INT(2, list->position);
+    List_delete(list, list->head);
+    TEST_ASSERT_EQUAL_INT(1, list->position);
+
+    List_clear(list);
+    TEST_ASSERT_NULL(list->current);
+    TEST_ASSERT_EQUAL_INT(0, list->position);
+
+    List_free(list);
+}
+
+void test_list_cursor_random() {
+    List *list = List_new(NULL);
+    Node *nodes[300];
+    int size = 0;
+
+    srand(2);
+    for (int step = 0; step < 5000; step++) {
+        int index = size ? rand() % size : 0;
+        int action = rand() % 8;
+        if (size == (int) LENGTH(nodes) || (size && action == 0)) {
+            List_delete_at(list, index);
+            memmove(nodes + index, nodes + index + 1, (size - index - 1) * sizeof(Node *));
+            size--;
+        } else if (size && action == 1) {
+            List_delete(list, nodes[index]);
+            memmove(nodes + index, nodes + index + 1, (size - index - 1) * sizeof(Node *));
+            size--;
+        } else if (size > 1 && action == 2) {
+            int other = (index + 1 + rand() % (size - 1)) % size;
+            List_swap(list, nodes[index], nodes[other]);
+            Node *temp = nodes[index];
+            nodes[index] = nodes[other];
+            nodes[other] = temp;
+        } else if (size > 1 && action == 3) {
+            List_shift_left(list);
+            Node *temp = nodes[0];
+            memmove(nodes, nodes + 1, (size - 1) * sizeof(Node *));
+            nodes[size - 1] = temp;
+        } else if (size && action == 4) {
+            TEST_ASSERT_EQUAL_INT(index, List_get_index(list, nodes[index]));
+        } else if (size && action == 5) {
+            Node *node = List_add_after(list, nodes[index], NULL);
+            index++;
+            memmove(nodes + index + 1, nodes + index, (size - index) * sizeof(Node *));
+            nodes[index] = node;
+            size++;
+        } else {
+            Node *node = size ? List_add_at(list, index, NULL) : List_add_head(list, NULL);
+            memmove(nodes + index + 1, nodes + index, (size - index) * sizeof(Node *));
+            nodes[index] = node;
+            size++;
+        }
+        if (list->current) {
+            TEST_ASSERT_EQUAL_PTR(nodes[list->position], list->current);
+        }
+    }
+    TEST_ASSERT_EQUAL_INDEX(list, nodes, size);
+
+    List_free(list);
+}
+
 int main(void) {
    UnityBegin("test/test_list.c");
 
    RUN_TEST(test_list_new);
+   RUN_TEST(test_list_new_pooled);
+   RUN_TEST(test_list_new_cached);
+   RUN_TEST(test_list_cache_trim);
    RUN_TEST(test_list_add_head);
    RUN_TEST(test_list_add_tail);
    RUN_TEST(test_list_add_before);
@@ -544,15 +1830,48 @@ int main(void) {
    RUN_TEST(test_list_is_empty);
    RUN_TEST(test_list_has_some);
    RUN_TEST(test_list_contains);
+   RUN_TEST(test_list_contains_owner);
+   RUN_TEST(test_list_is_before);
    RUN_TEST(test_list_get_index);
    RUN_TEST(test_list_get_at);
    RUN_TEST(test_list_swap);
    RUN_TEST(test_list_shift_left);
    RUN_TEST(test_list_shift_right);
    RUN_TEST(test_list_reverse);
+   RUN_TEST(test_list_reverse_even);
+   RUN_TEST(test_list_rotate);
+   RUN_TEST(test_list_splice);
+   RUN_TEST(test_list_concat);
+   RUN_TEST(test_list_split_at);
+   RUN_TEST(test_list_sort);
+   RUN_TEST(test_list_merge_sorted);
+   RUN_TEST(test_list_move_alloc);
+   RUN_TEST(test_list_reverse_cursor);
+   RUN_TEST(test_list_flip);
+   RUN_TEST(test_list_flip_add);
+   RUN_TEST(test_list_flip_add_many);
+   RUN_TEST(test_list_flip_sort);
+   RUN_TEST(test_list_iter);
+   RUN_TEST(test_list_iter_delete);
+   RUN_TEST(test_list_foreach);
+   RUN_TEST(test_list_compact);
+   RUN_TEST(test_list_compact_range);
+   RUN_TEST(test_list_compact_memory);
+   RUN_TEST(test_list_from_array);
+   RUN_TEST(test_list_add_many);
+   RUN_TEST(test_list_delete_if);
+   RUN_TEST(test_list_filter);
+   RUN_TEST(test_list_unique);
    RUN_TEST(test_list_clear);
+   RUN_TEST(test_list_clear_pooled);
+   RUN_TEST(test_list_clear_without_free);
    RUN_TEST(test_list_delete);
    RUN_TEST(test_list_delete_at);
+   RUN_TEST(test_list_index);
+   RUN_TEST(test_list_index_random);
+   RUN_TEST(test_list_cursor);
+   RUN_TEST(test_list_cursor_drift);
+   RUN_TEST(test_list_cursor_random);
 
    UnityEnd();
    return 0;
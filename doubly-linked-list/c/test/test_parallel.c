@@ -0,0 +1,189 @@
+#include <pthread.h>
+#include <stdint.h>
+
+#include "vendor/unity.h"
+#include "../src/parallel.h"
+
+#define SIZE 1000
+#define BROKEN UINTPTR_MAX
+
+static int counts[SIZE];
+static int spawns = -1;
+
+/*
+ * Linked in place of pthread_create, failing once spawns
+ * more threads have started, unlimited when negative
+ */
+int __real_pthread_create(pthread_t *thread, const pthread_attr_t *attr, void *(*start)(void *), void *arg);
+
+int __wrap_pthread_create(pthread_t *thread, const pthread_attr_t *attr, void *(*start)(void *), void *arg) {
+    if (!spawns) {
+        return 1;
+    }
+    spawns--;
+    return __real_pthread_create(thread, attr, start, arg);
+}
+
+static void count(void *data, void *arg) {
+    (void) arg;
+    counts[(uintptr_t) data - 1]++;
+}
+
+static void *sum(void *acc, void *data) {
+    return (void *) ((uintptr_t) acc + (uintptr_t) data);
+}
+
+/*
+ * Accumulate the first and last of a run of consecutive
+ * values, BROKEN once one comes out of order
+ */
+static void *run(void *acc, void *data) {
+    uintptr_t a = (uintptr_t) acc;
+    uintptr_t value = (uintptr_t) data;
+    if (a == BROKEN) {
+        return acc;
+    }
+    if (!a) {
+        return (void *) (value << 16 | value);
+    }
+    return (void *) ((a & 0xffff) + 1 == value ? (a & ~(uintptr_t) 0xffff) | value : BROKEN);
+}
+
+static void *join(void *a, void *b) {
+    uintptr_t x = (uintptr_t) a;
+    uintptr_t y = (uintptr_t) b;
+    if (x == BROKEN || y == BROKEN) {
+        return (void *) BROKEN;
+    }
+    if (!x || !y) {
+        return (void *) (x | y);
+    }
+    return (void *) ((x & 0xffff) + 1 == y >> 16 ? (x & ~(uintptr_t) 0xffff) | (y & 0xffff) : BROKEN);
+}
+
+static List *values(int size) {
+    List *list = List_new(NULL);
+    for (int i = 1; i <= size; i++) {
+        List_add_tail(list, (void *) (uintptr_t) i);
+    }
+    return list;
+}
+
+void test_parallel_foreach(void) {
+    List *list = values(SIZE);
+    int threads[] = { 1, 2, 4, 7, 0 };
+
+    for (int t = 0; t < 5; t++) {
+        for (int i = 0; i < SIZE; i++) {
+            counts[i] = 0;
+        }
+        List_parallel_foreach(list, count, NULL, threads[t]);
+        for (int i = 0; i < SIZE; i++) {
+            TEST_ASSERT_EQUAL_INT(1, counts[i]);
+        }
+    }
+
+    List_free(list);
+}
+
+void test_parallel_reduce() {
+    List *list = values(SIZE);
+
+    for (int threads = 1; threads <= 8; threads++) {
+        TEST_ASSERT_EQUAL_UINT64(SIZE * (SIZE + 1) / 2,
+                                 (uintptr_t) List_parallel_reduce(list, sum, sum, NULL, threads));
+        TEST_ASSERT_EQUAL_UINT64(1 << 16 | SIZE,
+                                 (uintptr_t) List_parallel_reduce(list, run, join, NULL, threads));
+    }
+
+    List_free(list);
+}
+
+void test_parallel_small() {
+    List *list = values(0);
+    TEST_ASSERT_NULL(List_parallel_reduce(list, sum, sum, NULL, 4));
+    List_parallel_foreach(list, count, NULL, 4);
+
+    List_add_tail(list, (void *) 3);
+    List_add_tail(list, (void *) 4);
+    TEST_ASSERT_EQUAL_UINT64(7, (uintptr_t) List_parallel_reduce(list, sum, sum, NULL, 8));
+    TEST_ASSERT_EQUAL_UINT64(3 << 16 | 4, (uintptr_t) List_parallel_reduce(list, run, join, NULL, 8));
+
+    List_free(list);
+}
+
+void test_parallel_view() {
+    List *list = List_new(NULL);
+    for (int i = SIZE; i >= 1; i--) {
+        List_add_tail(list, (void *) (uintptr_t) i);
+    }
+    TEST_ASSERT_EQUAL_UINT64(BROKEN, (uintptr_t) List_parallel_reduce(list, run, join, NULL, 4));
+
+    List_flip(list);
+    TEST_ASSERT_EQUAL_UINT64(1 << 16 | SIZE,
+                             (uintptr_t) List_parallel_reduce(list, run, join, NULL, 4));
+
+    List_free(list);
+}
+
+/*
+ * Pool threads that fail to start are not waited for, the call
+ * runs on the threads that did start
+ */
+void test_parallel_spawn_failure() {
+    List *list = values(SIZE);
+
+    spawns = 0;
+    TEST_ASSERT_EQUAL_UINT64(SIZE * (SIZE + 1) / 2,
+                             (uintptr_t) List_parallel_reduce(list, sum, sum, NULL, 4));
+    spawns = 2;
+    for (int i = 0; i < SIZE; i++) {
+        counts[i] = 0;
+    }
+    List_parallel_foreach(list, count, NULL, 8);
+    for (int i = 0; i < SIZE; i++) {
+        TEST_ASSERT_EQUAL_INT(1, counts[i]);
+    }
+    TEST_ASSERT_EQUAL_INT(0, spawns);
+    TEST_ASSERT_EQUAL_UINT64(1 << 16 | SIZE,
+                             (uintptr_t) List_parallel_reduce(list, run, join, NULL, 8));
+    spawns = -1;
+
+    List_free(list);
+}
+
+static List *inner;
+
+static void *sum_inner(void *acc, void *data) {
+    (void) data;
+    return (void *) ((uintptr_t) acc + (uintptr_t) List_parallel_reduce(inner, sum, sum, NULL, 4));
+}
+
+/*
+ * A call from inside a callback runs on the calling thread
+ * instead of waiting for the pool
+ */
+void test_parallel_nested() {
+    List *list = values(10);
+    inner = values(100);
+
+    uintptr_t nested = (uintptr_t) List_parallel_reduce(list, sum_inner, sum, NULL, 4);
+    TEST_ASSERT_EQUAL_UINT64(10 * 5050, nested);
+
+    List_free(inner);
+    List_free(list);
+}
+
+int main(void) {
+   UnityBegin("test/test_parallel.c");
+
+   RUN_TEST(test_parallel_spawn_failure);
+   RUN_TEST(test_parallel_foreach);
+   RUN_TEST(test_parallel_reduce);
+   RUN_TEST(test_parallel_small);
+   RUN_TEST(test_parallel_view);
+   RUN_TEST(test_parallel_nested);
+
+   UnityEnd();
+   return 0;
+}
@@ -0,0 +1,170 @@
+#include "vendor/unity.h"
+#include "../src/pool.h"
+
+void test_pool_new(void) {
+    Pool *pool = Pool_new(1, 4);
+
+    TEST_ASSERT_NULL(pool->chunks);
+    TEST_ASSERT_NULL(pool->free);
+    TEST_ASSERT_EQUAL_INT(sizeof(void *), pool->size);
+    TEST_ASSERT_EQUAL_INT(4, pool->count);
+    TEST_ASSERT_EQUAL_INT(0, pool->used);
+
+    Pool_free(pool);
+}
+
+void test_pool_alloc(void) {
+    Pool *pool = Pool_new(sizeof(int), 2);
+
+    int *a = Pool_alloc(pool);
+    int *b = Pool_alloc(pool);
+    Chunk *chunk = pool->chunks;
+    TEST_ASSERT_EQUAL_PTR(chunk->slots, a);
+    TEST_ASSERT_EQUAL_PTR(chunk->slots + pool->size, b);
+    TEST_ASSERT_EQUAL_INT(0, *a);
+    TEST_ASSERT_EQUAL_INT(0, *b);
+    TEST_ASSERT_EQUAL_INT(2, pool->used);
+
+    int *c = Pool_alloc(pool);
+    TEST_ASSERT_NOT_EQUAL(chunk, pool->chunks);
+    TEST_ASSERT_EQUAL_PTR(chunk, pool->chunks->next);
+    TEST_ASSERT_EQUAL_PTR(pool->chunks->slots, c);
+    TEST_ASSERT_EQUAL_INT(3, pool->used);
+
+    Pool_free(pool);
+}
+
+void test_pool_alloc_many() {
+    Pool *pool = Pool_new(sizeof(int), 4);
+
+    int *a = Pool_alloc(pool);
+    Chunk *chunk = pool->chunks;
+    int *many = Pool_alloc_many(pool, 10);
+    TEST_ASSERT_EQUAL_PTR(chunk, pool->chunks);
+    TEST_ASSERT_EQUAL_PTR(many, chunk->next->slots);
+    TEST_ASSERT_EQUAL_INT(10, chunk->next->used);
+    TEST_ASSERT_EQUAL_INT(11, pool->used);
+    for (int i = 0; i < 10; i++) {
+        TEST_ASSERT_EQUAL_INT(0, many[i * pool->size / sizeof(int)]);
+    }
+
+    int *b = Pool_alloc(pool);
+    TEST_ASSERT_EQUAL_PTR((char *) a + pool->size, b);
+
+    Pool_release(pool, many);
+    TEST_ASSERT_EQUAL_PTR(many, Pool_alloc(pool));
+    TEST_ASSERT_EQUAL_INT(12, pool->used);
+
+    Pool_free(pool);
+}
+
+void test_pool_release() {
+    Pool *pool = Pool_new(sizeof(int), 4);
+
+    int *a = Pool_alloc(pool);
+    int *b = Pool_alloc(pool);
+    *a = 1;
+    *b = 2;
+
+    Pool_release(pool, a);
+    TEST_ASSERT_EQUAL_INT(1, pool->used);
+
+    Pool_release(pool, b);
+    TEST_ASSERT_EQUAL_INT(0, pool->used);
+
+    TEST_ASSERT_EQUAL_PTR(b, Pool_alloc(pool));
+    TEST_ASSERT_EQUAL_INT(0, *b);
+    TEST_ASSERT_EQUAL_PTR(a, Pool_alloc(pool));
+    TEST_ASSERT_EQUAL_INT(0, *a);
+    TEST_ASSERT_EQUAL_INT(2, pool->used);
+
+    Pool_free(pool);
+}
+
+void test_pool_clear() {
+    Pool *pool = Pool_new(sizeof(int), 2);
+
+    for (int i = 0; i < 5; i++) {
+        Pool_alloc(pool);
+    }
+    Pool_release(pool, pool->chunks->slots);
+
+    Pool_clear(pool);
+    TEST_ASSERT_NULL(pool->chunks);
+    TEST_ASSERT_NULL(pool->free);
+    TEST_ASSERT_EQUAL_INT(0, pool->used);
+
+    TEST_ASSERT_NOT_NULL(Pool_alloc(pool));
+    TEST_ASSERT_EQUAL_INT(1, pool->used);
+
+    Pool_free(pool);
+}
+
+void test_pool_retain() {
+    Pool *pool = Pool_new(sizeof(int), 2);
+
+    TEST_ASSERT_EQUAL_PTR(pool, Pool_retain(pool));
+    TEST_ASSERT_EQUAL_INT(2, pool->refs);
+
+    Pool_alloc(pool);
+    Pool_free(pool);
+    TEST_ASSERT_EQUAL_INT(1, pool->refs);
+    TEST_ASSERT_EQUAL_INT(1, pool->used);
+
+    Pool_free(pool);
+}
+
+static int chunks(Pool *pool) {
+    int count = 0;
+    for (Chunk *chunk = pool->chunks; chunk; chunk = chunk->next) {
+        count++;
+    }
+    return count;
+}
+
+void test_pool_trim() {
+    Pool *pool = Pool_new(sizeof(int), 2);
+    TEST_ASSERT_EQUAL_INT(0, Pool_trim(pool));
+
+    int *objects[6];
+    for (int i = 0; i < 6; i++) {
+        objects[i] = Pool_alloc(pool);
+    }
+    char *block = Pool_alloc_many(pool, 3);
+    TEST_ASSERT_EQUAL_INT(4, chunks(pool));
+    TEST_ASSERT_EQUAL_INT(0, Pool_trim(pool));
+
+    Pool_release(pool, objects[0]);
+    Pool_release(pool, block + pool->size);
+    Pool_release(pool, objects[1]);
+    Pool_release(pool, objects[2]);
+    Pool_release(pool, block);
+    Pool_release(pool, block + 2 * pool->size);
+    TEST_ASSERT_EQUAL_INT(2, Pool_trim(pool));
+    TEST_ASSERT_EQUAL_INT(2, chunks(pool));
+    TEST_ASSERT_EQUAL_INT(3, pool->used);
+
+    TEST_ASSERT_EQUAL_PTR(objects[2], Pool_alloc(pool));
+    TEST_ASSERT_NULL(pool->free);
+    TEST_ASSERT_EQUAL_INT(0, Pool_trim(pool));
+    int *object = Pool_alloc(pool);
+    TEST_ASSERT_EQUAL_INT(3, chunks(pool));
+    TEST_ASSERT_EQUAL_INT(0, *object);
+
+    Pool_free(pool);
+}
+
+int main(void) {
+   UnityBegin("test/test_pool.c");
+
+   RUN_TEST(test_pool_new);
+   RUN_TEST(test_pool_alloc);
+   RUN_TEST(test_pool_alloc_many);
+   RUN_TEST(test_pool_release);
+   RUN_TEST(test_pool_clear);
+   RUN_TEST(test_pool_retain);
+   RUN_TEST(test_pool_trim);
+
+   UnityEnd();
+   return 0;
+}
@@ -0,0 +1,195 @@
+#include <string.h>
+
+#include "vendor/unity.h"
+#include "../src/rank.h"
+
+#define LENGTH(xs) (sizeof(xs) / sizeof(xs[0]))
+
+size_t TEST_ASSERT_VALID_RANK(Rank *rank, Rank *parent) {
+    if (!rank) {
+        return 0;
+    }
+    TEST_ASSERT_EQUAL_PTR(parent, rank->parent);
+    if (parent) {
+        TEST_ASSERT_TRUE(rank->priority <= parent->priority);
+    }
+    size_t count = 1 + TEST_ASSERT_VALID_RANK(rank->left, rank) + TEST_ASSERT_VALID_RANK(rank->right, rank);
+    TEST_ASSERT_EQUAL_INT(count, rank->count);
+    return count;
+}
+
+void TEST_ASSERT_EQUAL_RANKS(Rank *root, Rank *ranks[], int size) {
+    TEST_ASSERT_EQUAL_INT(size, TEST_ASSERT_VALID_RANK(root, NULL));
+    for (int i = 0; i < size; i++) {
+        TEST_ASSERT_EQUAL_PTR(ranks[i], Rank_select(root, i));
+        TEST_ASSERT_EQUAL_INT(i, Rank_index(ranks[i]));
+        TEST_ASSERT_EQUAL_PTR(root, Rank_root(ranks[i]));
+    }
+    TEST_ASSERT_NULL(Rank_select(root, size));
+}
+
+void test_rank_new(void) {
+    int item;
+    Rank *rank = Rank_new(&item);
+
+    TEST_ASSERT_EQUAL_PTR(&item, rank->item);
+    TEST_ASSERT_NULL(rank->parent);
+    TEST_ASSERT_NULL(rank->left);
+    TEST_ASSERT_NULL(rank->right);
+    TEST_ASSERT_EQUAL_INT(1, rank->count);
+    TEST_ASSERT_EQUAL_INT(0, Rank_index(rank));
+
+    Rank_free(rank);
+}
+
+void test_rank_insert() {
+    Rank *root = NULL;
+    Rank *rank1 = Rank_new(NULL);
+    Rank *rank2 = Rank_new(NULL);
+    Rank *rank3 = Rank_new(NULL);
+    Rank *rank4 = Rank_new(NULL);
+
+    Rank_insert_after(&root, NULL, rank1);
+    Rank *ranks1[] = { rank1 };
+    TEST_ASSERT_EQUAL_RANKS(root, ranks1, LENGTH(ranks1));
+
+    Rank_insert_before(&root, rank1, rank2);
+    Rank *ranks2[] = { rank2, rank1 };
+    TEST_ASSERT_EQUAL_RANKS(root, ranks2, LENGTH(ranks2));
+
+    Rank_insert_after(&root, rank2, rank3);
+    Rank *ranks3[] = { rank2, rank3, rank1 };
+    TEST_ASSERT_EQUAL_RANKS(root, ranks3, LENGTH(ranks3));
+
+    Rank_insert_before(&root, rank3, rank4);
+    Rank *ranks4[] = { rank2, rank4, rank3, rank1 };
+    TEST_ASSERT_EQUAL_RANKS(root, ranks4, LENGTH(ranks4));
+
+    for (int i = 0; i < (int) LENGTH(ranks4); i++) {
+        Rank_free(ranks4[i]);
+    }
+}
+
+void test_rank_remove() {
+    Rank *root = NULL;
+    Rank *ranks[16];
+    for (int i = 0; i < (int) LENGTH(ranks); i++) {
+        ranks[i] = Rank_new(NULL);
+        Rank_insert_after(&root, i ? ranks[i-1] : NULL, ranks[i]);
+    }
+    TEST_ASSERT_EQUAL_RANKS(root, ranks, LENGTH(ranks));
+
+    Rank *removed = ranks[5];
+    Rank_remove(&root, removed);
+    TEST_ASSERT_NULL(removed->parent);
+    TEST_ASSERT_EQUAL_INT(1, removed->count);
+    memmove(ranks + 5, ranks + 6, 10 * sizeof(Rank *));
+    TEST_ASSERT_EQUAL_RANKS(root, ranks, 15);
+    Rank_free(removed);
+
+    while (root) {
+        Rank *rank = root;
+        Rank_remove(&root, rank);
+        Rank_free(rank);
+    }
+}
+
+void test_rank_build() {
+    Rank *last = NULL;
+    TEST_ASSERT_NULL(Rank_build(last));
+
+    Rank *ranks[100];
+    for (int i = 0; i < (int) LENGTH(ranks); i++) {
+        ranks[i] = Rank_new(NULL);
+        Rank_append(&last, ranks[i]);
+    }
+    Rank *root = Rank_build(last);
+    TEST_ASSERT_EQUAL_RANKS(root, ranks, LENGTH(ranks));
+
+    for (int i = 0; i < (int) LENGTH(ranks); i++) {
+        Rank_free(ranks[i]);
+    }
+}
+
+void test_rank_random() {
+    Rank *root = NULL;
+    Rank *ranks[500];
+    int size = 0;
+
+    srand(1);
+    for (int step = 0; step < 5000; step++) {
+        int index = size ? rand() % size : 0;
+        if (size == (int) LENGTH(ranks) || (size && rand() % 3 == 0)) {
+            Rank *rank = ranks[index];
+            Rank_remove(&root, rank);
+            Rank_free(rank);
+            memmove(ranks + index, ranks + index + 1, (size - index - 1) * sizeof(Rank *));
+            size--;
+        } else {
+            Rank *rank = Rank_new(NULL);
+            if (!size) {
+                Rank_insert_before(&root, NULL, rank);
+            } else if (rand() % 2) {
+                Rank_insert_before(&root, ranks[index], rank);
+            } else {
+                Rank_insert_after(&root, ranks[index], rank);
+                index++;
+            }
+            memmove(ranks + index + 1, ranks + index, (size - index) * sizeof(Rank *));
+            ranks[index] = rank;
+            size++;
+        }
+    }
+    TEST_ASSERT_EQUAL_RANKS(root, ranks, size);
+
+    for (int i = 0; i < size; i++) {
+        Rank_free(ranks[i]);
+    }
+}
+
+void test_rank_map() {
+    RankMap *map = RankMap_new();
+    int items[200];
+    Rank *ranks[200];
+    for (int i = 0; i < (int) LENGTH(items); i++) {
+        ranks[i] = Rank_new(&items[i]);
+        RankMap_put(map, ranks[i]);
+    }
+    TEST_ASSERT_EQUAL_INT(LENGTH(items), map->count);
+
+    srand(1);
+    for (int i = 0; i < (int) LENGTH(items); i++) {
+        int index = rand() % LENGTH(items);
+        if (ranks[index]) {
+            TEST_ASSERT_EQUAL_PTR(ranks[index], RankMap_remove(map, &items[index]));
+            Rank_free(ranks[index]);
+            ranks[index] = NULL;
+        }
+        TEST_ASSERT_NULL(RankMap_remove(map, &items[index]));
+    }
+    for (int i = 0; i < (int) LENGTH(items); i++) {
+        TEST_ASSERT_EQUAL_PTR(ranks[i], RankMap_get(map, &items[i]));
+    }
+
+    for (int i = 0; i < (int) LENGTH(items); i++) {
+        Rank_free(ranks[i]);
+    }
+    RankMap_clear(map);
+    TEST_ASSERT_EQUAL_INT(0, map->count);
+    TEST_ASSERT_NULL(RankMap_get(map, &items[0]));
+    RankMap_free(map);
+}
+
+int main(void) {
+   UnityBegin("test/test_rank.c");
+
+   RUN_TEST(test_rank_new);
+   RUN_TEST(test_rank_insert);
+   RUN_TEST(test_rank_remove);
+   RUN_TEST(test_rank_build);
+   RUN_TEST(test_rank_random);
+   RUN_TEST(test_rank_map);
+
+   UnityEnd();
+   return 0;
+}
@@ -0,0 +1,189 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include <pthread.h>
+
+#include "vendor/unity.h"
+#include "../src/rlist.h"
+
+#define READERS 3
+#define SIZE    100
+#define UPDATES 20000
+
+static int freed;
+
+static void count_free(void *data) {
+    free(data);
+    freed++;
+}
+
+void TEST_ASSERT_EQUAL_RLIST(RList *list, RNode *nodes[], int size) {
+    RNode *prev = NULL;
+    RNode *node = RList_first(list);
+    for (int i = 0; i < size; i++) {
+        TEST_ASSERT_EQUAL_PTR(nodes[i], node);
+        TEST_ASSERT_EQUAL_PTR(prev, node->prev);
+        prev = node;
+        node = RList_next(node);
+    }
+    TEST_ASSERT_NULL(node);
+    TEST_ASSERT_EQUAL_PTR(prev, list->tail);
+    TEST_ASSERT_EQUAL_INT(size, list->size);
+}
+
+void test_rlist_new(void) {
+    RList *list = RList_new(free);
+
+    TEST_ASSERT_NULL(RList_first(list));
+    TEST_ASSERT_NULL(list->tail);
+    TEST_ASSERT_EQUAL_INT(0, list->size);
+
+    RList_free(list);
+}
+
+void test_rlist_add() {
+    RList *list = RList_new(NULL);
+
+    RNode *node1 = RList_add_tail(list, NULL);
+    RNode *node2 = RList_add_head(list, NULL);
+    RNode *node3 = RList_add_before(list, node2, NULL);
+    RNode *node4 = RList_add_after(list, node1, NULL);
+    RNode *node5 = RList_add_after(list, node2, NULL);
+
+    RNode *nodes[] = { node3, node2, node5, node1, node4 };
+    TEST_ASSERT_EQUAL_RLIST(list, nodes, 5);
+
+    RList_free(list);
+}
+
+void test_rlist_delete() {
+    RList *list = RList_new(count_free);
+    EpochThread *reader = RList_register(list);
+
+    RNode *node1 = RList_add_tail(list, malloc(sizeof(int)));
+    RNode *node2 = RList_add_tail(list, malloc(sizeof(int)));
+    RNode *node3 = RList_add_tail(list, malloc(sizeof(int)));
+
+    freed = 0;
+    RList_read_lock(reader);
+    RNode *seen = RList_first(list);
+    RList_delete(list, node1);
+    RList_delete(list, node3);
+    TEST_ASSERT_EQUAL_PTR(node1, seen);
+    TEST_ASSERT_EQUAL_PTR(node2, RList_next(seen));
+    for (int i = 0; i < 10; i++) {
+        Epoch_collect(list->writer);
+    }
+    TEST_ASSERT_EQUAL_INT(0, freed);
+    RList_read_unlock(reader);
+
+    RList_synchronize(list);
+    TEST_ASSERT_EQUAL_INT(2, freed);
+    RNode *nodes[] = { node2 };
+    TEST_ASSERT_EQUAL_RLIST(list, nodes, 1);
+
+    RList_delete(list, node2);
+    TEST_ASSERT_EQUAL_RLIST(list, NULL, 0);
+
+    RList_unregister(reader);
+    RList_free(list);
+    TEST_ASSERT_EQUAL_INT(3, freed);
+}
+
+void test_rlist_replace() {
+    RList *list = RList_new(count_free);
+
+    RNode *node1 = RList_add_tail(list, malloc(sizeof(int)));
+    RNode *node2 = RList_add_tail(list, malloc(sizeof(int)));
+
+    freed = 0;
+    int *data = malloc(sizeof(int));
+    RNode *copy2 = RList_replace(list, node2, data);
+    RNode *copy1 = RList_replace(list, node1, malloc(sizeof(int)));
+    RNode *nodes[] = { copy1, copy2 };
+    TEST_ASSERT_EQUAL_RLIST(list, nodes, 2);
+    TEST_ASSERT_EQUAL_PTR(data, copy2->data);
+
+    RList_synchronize(list);
+    TEST_ASSERT_EQUAL_INT(2, freed);
+
+    RList_free(list);
+}
+
+static RList *shared;
+static atomic_int done;
+
+/*
+ * Walk the list over and over while the writer replaces
+ * elements, every element read must be a live one. A walk never
+ * misses an element, but standing on an RNode deleted after an
+ * add_after it may see the old and new versions of one
+ */
+static void *walk(void *arg) {
+    (void) arg;
+    EpochThread *thread = RList_register(shared);
+    int ok = 1;
+    while (!atomic_load(&done)) {
+        RList_read_lock(thread);
+        int size = 0;
+        for (RNode *node = RList_first(shared); node; node = RList_next(node)) {
+            ok &= *(int *) node->data >= 0;
+            size++;
+        }
+        ok &= size >= SIZE;
+        RList_read_unlock(thread);
+    }
+    RList_unregister(thread);
+    return ok ? (void *) &done : NULL;
+}
+
+void test_rlist_threads() {
+    shared = RList_new(free);
+    RNode *nodes[SIZE];
+    for (int i = 0; i < SIZE; i++) {
+        int *data = malloc(sizeof(int));
+        *data = i;
+        nodes[i] = RList_add_tail(shared, data);
+    }
+
+    atomic_store(&done, 0);
+    pthread_t readers[READERS];
+    for (int i = 0; i < READERS; i++) {
+        pthread_create(&readers[i], NULL, walk, NULL);
+    }
+
+    for (int i = 0; i < UPDATES; i++) {
+        int *data = malloc(sizeof(int));
+        *data = i;
+        int index = i % SIZE;
+        if (i % 2) {
+            nodes[index] = RList_replace(shared, nodes[index], data);
+        } else {
+            RNode *node = RList_add_after(shared, nodes[index], data);
+            RList_delete(shared, nodes[index]);
+            nodes[index] = node;
+        }
+    }
+    atomic_store(&done, 1);
+
+    for (int i = 0; i < READERS; i++) {
+        void *ok;
+        pthread_join(readers[i], &ok);
+        TEST_ASSERT_NOT_NULL(ok);
+    }
+    TEST_ASSERT_EQUAL_RLIST(shared, nodes, SIZE);
+
+    RList_free(shared);
+}
+
+int main(void) {
+   UnityBegin("test/test_rlist.c");
+
+   RUN_TEST(test_rlist_new);
+   RUN_TEST(test_rlist_add);
+   RUN_TEST(test_rlist_delete);
+   RUN_TEST(test_rlist_replace);
+   RUN_TEST(test_rlist_threads);
+
+   UnityEnd();
+   return 0;
+}
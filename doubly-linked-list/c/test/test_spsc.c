@@ -0,0 +1,138 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include <pthread.h>
+#include <sched.h>
+
+#include "vendor/unity.h"
+#include "../src/spsc.h"
+
+#define ITEMS 1000000
+
+void test_spsc_new(void) {
+    Spsc *queue = Spsc_new(4, NULL);
+    void *data = NULL;
+
+    TEST_ASSERT_EQUAL_INT(4, queue->capacity);
+    TEST_ASSERT_EQUAL_INT(0, Spsc_size(queue));
+    TEST_ASSERT_FALSE(Spsc_pop(queue, &data));
+    TEST_ASSERT_NULL(data);
+    for (int i = 0; i < 4; i++) {
+        TEST_ASSERT_EQUAL_PTR(&queue->nodes[(i + 1) % 4], queue->nodes[i].next);
+    }
+
+    Spsc_free(queue);
+}
+
+void test_spsc_push_pop() {
+    Spsc *queue = Spsc_new(3, NULL);
+    int items[8];
+    void *data;
+
+    for (int round = 0; round < 3; round++) {
+        TEST_ASSERT_TRUE(Spsc_push(queue, &items[0]));
+        TEST_ASSERT_TRUE(Spsc_push(queue, &items[1]));
+        TEST_ASSERT_TRUE(Spsc_push(queue, &items[2]));
+        TEST_ASSERT_FALSE(Spsc_push(queue, &items[3]));
+        TEST_ASSERT_EQUAL_INT(3, Spsc_size(queue));
+
+        for (int i = 0; i < 3; i++) {
+            TEST_ASSERT_TRUE(Spsc_pop(queue, &data));
+            TEST_ASSERT_EQUAL_PTR(&items[i], data);
+        }
+        TEST_ASSERT_FALSE(Spsc_pop(queue, &data));
+    }
+
+    Spsc_free(queue);
+}
+
+void test_spsc_many() {
+    Spsc *queue = Spsc_new(5, NULL);
+    int items[8];
+    void *in[] = { &items[0], &items[1], &items[2], &items[3], &items[4], &items[5] };
+    void *out[8];
+
+    TEST_ASSERT_EQUAL_INT(5, Spsc_push_many(queue, in, 6));
+    TEST_ASSERT_EQUAL_INT(2, Spsc_pop_many(queue, out, 2));
+    TEST_ASSERT_EQUAL_PTR(&items[0], out[0]);
+    TEST_ASSERT_EQUAL_PTR(&items[1], out[1]);
+
+    TEST_ASSERT_EQUAL_INT(1, Spsc_push_many(queue, in + 5, 1));
+    TEST_ASSERT_EQUAL_INT(4, Spsc_pop_many(queue, out, 8));
+    TEST_ASSERT_EQUAL_PTR(&items[2], out[0]);
+    TEST_ASSERT_EQUAL_PTR(&items[5], out[3]);
+    TEST_ASSERT_EQUAL_INT(0, Spsc_pop_many(queue, out, 8));
+
+    Spsc_free(queue);
+}
+
+void test_spsc_free() {
+    Spsc *queue = Spsc_new(8, free);
+
+    for (int i = 0; i < 6; i++) {
+        Spsc_push(queue, malloc(sizeof(int)));
+    }
+    void *data;
+    Spsc_pop(queue, &data);
+    free(data);
+
+    Spsc_free(queue);
+}
+
+static void *produce(void *arg) {
+    Spsc *queue = arg;
+    void *batch[16];
+    size_t next = 1;
+    while (next <= ITEMS) {
+        size_t count = 0;
+        for (; count < 16 && next + count <= ITEMS; count++) {
+            batch[count] = (void *) (next + count);
+        }
+        size_t pushed = 0;
+        while (pushed < count) {
+            size_t done = Spsc_push_many(queue, batch + pushed, count - pushed);
+            if (!done) {
+                sched_yield();
+            }
+            pushed += done;
+        }
+        next += count;
+    }
+    return NULL;
+}
+
+void test_spsc_threads() {
+    Spsc *queue = Spsc_new(64, NULL);
+    pthread_t producer;
+    pthread_create(&producer, NULL, produce, queue);
+
+    size_t expected = 1;
+    int ordered = 1;
+    while (expected <= ITEMS) {
+        void *data;
+        if (Spsc_pop(queue, &data)) {
+            ordered &= (size_t) data == expected;
+            expected++;
+        } else {
+            sched_yield();
+        }
+    }
+    pthread_join(producer, NULL);
+
+    TEST_ASSERT_TRUE(ordered);
+    TEST_ASSERT_EQUAL_INT(0, Spsc_size(queue));
+
+    Spsc_free(queue);
+}
+
+int main(void) {
+   UnityBegin("test/test_spsc.c");
+
+   RUN_TEST(test_spsc_new);
+   RUN_TEST(test_spsc_push_pop);
+   RUN_TEST(test_spsc_many);
+   RUN_TEST(test_spsc_free);
+   RUN_TEST(test_spsc_threads);
+
+   UnityEnd();
+   return 0;
+}
@@ -0,0 +1,139 @@
+#include <pthread.h>
+
+#include "vendor/unity.h"
+#include "../src/list.h"
+
+static int destroyed;
+
+static void destroy(void *data) {
+    (void) data;
+    destroyed++;
+}
+
+void test_stats_allocs() {
+    List_stats_reset();
+    List *list = List_new(destroy);
+
+    Node *node = List_add_tail(list, NULL);
+    List_add_tail(list, NULL);
+    List_add_head(list, NULL);
+    List_delete(list, node);
+
+    ListStats stats;
+    List_stats(&stats);
+    TEST_ASSERT_EQUAL_INT(3, stats.allocs);
+    TEST_ASSERT_EQUAL_INT(1, stats.frees);
+    TEST_ASSERT_EQUAL_INT(1, stats.destructors);
+
+    List_free(list);
+    List_stats(&stats);
+    TEST_ASSERT_EQUAL_INT(3, stats.frees);
+    TEST_ASSERT_EQUAL_INT(3, stats.destructors);
+    TEST_ASSERT_EQUAL_INT(destroyed, stats.destructors);
+}
+
+void test_stats_pooled() {
+    Pool *pool = Pool_new(sizeof(Node), 4);
+    List *list = List_new_pooled(NULL, pool);
+    Pool_free(pool);
+
+    List_stats_reset();
+    for (int i = 0; i < 10; i++) {
+        List_add_tail(list, NULL);
+    }
+    List_clear(list);
+
+    ListStats stats;
+    List_stats(&stats);
+    TEST_ASSERT_EQUAL_INT(10, stats.allocs);
+    TEST_ASSERT_EQUAL_INT(10, stats.frees);
+    TEST_ASSERT_EQUAL_INT(0, stats.destructors);
+
+    List_free(list);
+}
+
+void test_stats_steps() {
+    List *list = List_new(NULL);
+    Node *nodes[10];
+    for (int i = 0; i < 10; i++) {
+        nodes[i] = List_add_tail(list, NULL);
+    }
+
+    List_stats_reset();
+    List_get_at(list, 3);
+    List_get_at(list, 4);
+    List_get_at(list, 8);
+
+    ListStats stats;
+    List_stats(&stats);
+    TEST_ASSERT_EQUAL_INT(3, stats.calls);
+    TEST_ASSERT_EQUAL_INT(3 + 1 + 1, stats.steps);
+
+    List_stats_reset();
+    List_get_index(list, nodes[6]);
+    List_add_at(list, 2, NULL);
+    List_stats(&stats);
+    TEST_ASSERT_EQUAL_INT(2, stats.calls);
+    TEST_ASSERT_EQUAL_INT(6 + 2, stats.steps);
+
+    List_free(list);
+}
+
+void test_stats_reset() {
+    List *list = List_new(NULL);
+    List_add_tail(list, NULL);
+    List_free(list);
+
+    List_stats_reset();
+    ListStats stats;
+    List_stats(&stats);
+    TEST_ASSERT_EQUAL_INT(0, stats.allocs);
+    TEST_ASSERT_EQUAL_INT(0, stats.frees);
+    TEST_ASSERT_EQUAL_INT(0, stats.steps);
+    TEST_ASSERT_EQUAL_INT(0, stats.destructors);
+    TEST_ASSERT_EQUAL_INT(0, stats.calls);
+}
+
+static void *stats_worker(void *arg) {
+    ListStats *stats = arg;
+    List *list = List_new(NULL);
+    for (int i = 0; i < 5; i++) {
+        List_add_tail(list, NULL);
+    }
+    List_free(list);
+    List_stats(stats);
+    return NULL;
+}
+
+void test_stats_threads() {
+    List_stats_reset();
+    List *list = List_new(NULL);
+    List_add_tail(list, NULL);
+
+    pthread_t thread;
+    ListStats worker;
+    pthread_create(&thread, NULL, stats_worker, &worker);
+    pthread_join(thread, NULL);
+    TEST_ASSERT_EQUAL_INT(5, worker.allocs);
+    TEST_ASSERT_EQUAL_INT(5, worker.frees);
+
+    ListStats stats;
+    List_stats(&stats);
+    TEST_ASSERT_EQUAL_INT(1, stats.allocs);
+    TEST_ASSERT_EQUAL_INT(0, stats.frees);
+
+    List_free(list);
+}
+
+int main(void) {
+   UnityBegin("test/test_stats.c");
+
+   RUN_TEST(test_stats_allocs);
+   RUN_TEST(test_stats_pooled);
+   RUN_TEST(test_stats_steps);
+   RUN_TEST(test_stats_reset);
+   RUN_TEST(test_stats_threads);
+
+   UnityEnd();
+   return 0;
+}
@@ -0,0 +1,259 @@
+#include <string.h>
+
+#include "vendor/unity.h"
+#include "../src/tlist.h"
+
+#define LENGTH(xs) (sizeof(xs) / sizeof(xs[0]))
+
+typedef struct {
+    int id;
+    char *name;
+} Entry;
+
+static int destroyed;
+
+static void Entry_destroy(Entry *entry) {
+    free(entry->name);
+    destroyed++;
+}
+
+LIST_DEFINE(IntList, int, LIST_TRIVIAL)
+LIST_DEFINE(EntryList, Entry, Entry_destroy)
+
+void TEST_ASSERT_EQUAL_INTLIST(IntList *list, int values[], int size) {
+    IntListNode *forward = IntList_first(list);
+    IntListNode *backward = IntList_last(list);
+    for (int i = 0; i < size; i++) {
+        TEST_ASSERT_EQUAL_INT(values[i], forward->data);
+        TEST_ASSERT_EQUAL_INT(values[size - i - 1], backward->data);
+        forward = IntList_next(list, forward);
+        backward = IntList_prev(list, backward);
+    }
+    TEST_ASSERT_NULL(forward);
+    TEST_ASSERT_NULL(backward);
+    TEST_ASSERT_EQUAL_INT(size, list->size);
+}
+
+static Entry entry(int id, const char *name) {
+    Entry entry = { id, malloc(strlen(name) + 1) };
+    strcpy(entry.name, name);
+    return entry;
+}
+
+void test_tlist_new(void) {
+    IntList *list = IntList_new();
+
+    TEST_ASSERT_NULL(list->head);
+    TEST_ASSERT_NULL(list->tail);
+    TEST_ASSERT_TRUE(IntList_is_empty(list));
+    TEST_ASSERT_NULL(IntList_get_at(list, 0));
+
+    IntList_free(list);
+}
+
+void test_tlist_add() {
+    IntList *list = IntList_new();
+
+    IntListNode *node1 = IntList_add_tail(list, 1);
+    IntList_add_head(list, 2);
+    IntList_add_before(list, node1, 3);
+    IntList_add_after(list, node1, 4);
+    int values[] = { 2, 3, 1, 4 };
+    TEST_ASSERT_EQUAL_INTLIST(list, values, LENGTH(values));
+
+    for (int i = 0; i < (int) LENGTH(values); i++) {
+        TEST_ASSERT_EQUAL_INT(values[i], IntList_get_at(list, i)->data);
+    }
+    TEST_ASSERT_NULL(IntList_get_at(list, 4));
+    TEST_ASSERT_NULL(IntList_get_at(list, -1));
+
+    IntList_free(list);
+}
+
+void test_tlist_reverse() {
+    IntList *list = IntList_new();
+    for (int i = 1; i <= 5; i++) {
+        IntList_add_tail(list, i);
+    }
+
+    IntList_reverse(list);
+    int values[] = { 5, 4, 3, 2, 1 };
+    TEST_ASSERT_EQUAL_INTLIST(list, values, LENGTH(values));
+
+    IntList_free(list);
+}
+
+void test_tlist_delete() {
+    IntList *list = IntList_new();
+    IntListNode *node1 = IntList_add_tail(list, 1);
+    IntList_add_tail(list, 2);
+    IntListNode *node3 = IntList_add_tail(list, 3);
+    IntList_add_tail(list, 4);
+
+    IntList_delete(list, node1);
+    IntList_delete(list, node3);
+    int values1[] = { 2, 4 };
+    TEST_ASSERT_EQUAL_INTLIST(list, values1, LENGTH(values1));
+
+    IntList_delete_at(list, 1);
+    IntList_delete_at(list, 1);
+    int values2[] = { 2 };
+    TEST_ASSERT_EQUAL_INTLIST(list, values2, LENGTH(values2));
+
+    IntList_clear(list);
+    TEST_ASSERT_EQUAL_INTLIST(list, NULL, 0);
+
+    IntList_free(list);
+}
+
+void test_tlist_index() {
+    IntList *list = IntList_new();
+    IntList *other = IntList_new();
+
+    TEST_ASSERT_FALSE(IntList_has_some(list));
+    TEST_ASSERT_NULL(IntList_add_at(list, 0, 1));
+    IntListNode *node1 = IntList_add_tail(list, 1);
+    IntListNode *node3 = IntList_add_tail(list, 3);
+    IntListNode *node2 = IntList_add_at(list, 1, 2);
+    IntListNode *node0 = IntList_add_at(list, 0, 0);
+    TEST_ASSERT_NULL(IntList_add_at(list, 4, 4));
+    TEST_ASSERT_TRUE(IntList_has_some(list));
+
+    int values[] = { 0, 1, 2, 3 };
+    TEST_ASSERT_EQUAL_INTLIST(list, values, LENGTH(values));
+    IntListNode *nodes[] = { node0, node1, node2, node3 };
+    for (int i = 0; i < (int) LENGTH(nodes); i++) {
+        TEST_ASSERT_EQUAL_INT(i, IntList_get_index(list, nodes[i]));
+        TEST_ASSERT_TRUE(IntList_contains(list, nodes[i]));
+        TEST_ASSERT_FALSE(IntList_contains(other, nodes[i]));
+    }
+    TEST_ASSERT_EQUAL_INT(-1, IntList_get_index(other, node0));
+    TEST_ASSERT_FALSE(IntList_contains(list, NULL));
+
+    IntList_free(other);
+    IntList_free(list);
+}
+
+void test_tlist_swap() {
+    IntList *list = IntList_new();
+    IntListNode *node1 = IntList_add_tail(list, 1);
+    IntListNode *node2 = IntList_add_tail(list, 2);
+    IntListNode *node3 = IntList_add_tail(list, 3);
+    IntListNode *node4 = IntList_add_tail(list, 4);
+
+    IntList_swap(list, node1, node2);
+    int values1[] = { 2, 1, 3, 4 };
+    TEST_ASSERT_EQUAL_INTLIST(list, values1, LENGTH(values1));
+
+    IntList_swap(list, node3, node1);
+    int values2[] = { 2, 3, 1, 4 };
+    TEST_ASSERT_EQUAL_INTLIST(list, values2, LENGTH(values2));
+
+    IntList_swap(list, node2, node4);
+    int values3[] = { 4, 3, 1, 2 };
+    TEST_ASSERT_EQUAL_INTLIST(list, values3, LENGTH(values3));
+
+    IntList_swap(list, node2, node3);
+    IntList_swap(list, node1, node1);
+    int values4[] = { 4, 2, 1, 3 };
+    TEST_ASSERT_EQUAL_INTLIST(list, values4, LENGTH(values4));
+
+    IntList_free(list);
+}
+
+void test_tlist_rotate() {
+    IntList *list = IntList_new();
+    IntList_shift_left(list);
+    for (int i = 1; i <= 5; i++) {
+        IntList_add_tail(list, i);
+    }
+
+    IntList_shift_left(list);
+    int values1[] = { 2, 3, 4, 5, 1 };
+    TEST_ASSERT_EQUAL_INTLIST(list, values1, LENGTH(values1));
+
+    IntList_shift_right(list);
+    IntList_shift_right(list);
+    int values2[] = { 5, 1, 2, 3, 4 };
+    TEST_ASSERT_EQUAL_INTLIST(list, values2, LENGTH(values2));
+
+    IntList_rotate(list, 7);
+    int values3[] = { 2, 3, 4, 5, 1 };
+    TEST_ASSERT_EQUAL_INTLIST(list, values3, LENGTH(values3));
+
+    IntList_rotate(list, -5);
+    TEST_ASSERT_EQUAL_INTLIST(list, values3, LENGTH(values3));
+
+    IntList_free(list);
+}
+
+void test_tlist_concat_split() {
+    IntList *list = IntList_new();
+    IntList *other = IntList_new();
+
+    IntList_concat(list, other);
+    TEST_ASSERT_EQUAL_INTLIST(list, NULL, 0);
+    IntList_add_tail(other, 1);
+    IntList_add_tail(other, 2);
+    IntList_concat(list, other);
+    IntList_add_tail(other, 3);
+    IntList_concat(list, other);
+    int values1[] = { 1, 2, 3 };
+    TEST_ASSERT_EQUAL_INTLIST(list, values1, LENGTH(values1));
+    TEST_ASSERT_EQUAL_INTLIST(other, NULL, 0);
+    IntList_free(other);
+
+    TEST_ASSERT_NULL(IntList_split_at(list, -1));
+    TEST_ASSERT_NULL(IntList_split_at(list, 4));
+    IntList *empty = IntList_split_at(list, 3);
+    TEST_ASSERT_EQUAL_INTLIST(empty, NULL, 0);
+    IntList_free(empty);
+
+    IntList *tail = IntList_split_at(list, 1);
+    int values2[] = { 1 };
+    int values3[] = { 2, 3 };
+    TEST_ASSERT_EQUAL_INTLIST(list, values2, LENGTH(values2));
+    TEST_ASSERT_EQUAL_INTLIST(tail, values3, LENGTH(values3));
+
+    IntList *all = IntList_split_at(tail, 0);
+    TEST_ASSERT_EQUAL_INTLIST(tail, NULL, 0);
+    TEST_ASSERT_EQUAL_INTLIST(all, values3, LENGTH(values3));
+
+    IntList_free(all);
+    IntList_free(tail);
+    IntList_free(list);
+}
+
+void test_tlist_destructor() {
+    EntryList *list = EntryList_new();
+    destroyed = 0;
+
+    EntryListNode *node = EntryList_add_tail(list, entry(1, "one"));
+    EntryList_add_tail(list, entry(2, "two"));
+    EntryList_add_tail(list, entry(3, "three"));
+    TEST_ASSERT_EQUAL_STRING("two", EntryList_get_at(list, 1)->data.name);
+
+    EntryList_delete(list, node);
+    TEST_ASSERT_EQUAL_INT(1, destroyed);
+    TEST_ASSERT_EQUAL_INT(2, EntryList_first(list)->data.id);
+
+    EntryList_free(list);
+    TEST_ASSERT_EQUAL_INT(3, destroyed);
+}
+
+int main(void) {
+   UnityBegin("test/test_tlist.c");
+
+   RUN_TEST(test_tlist_new);
+   RUN_TEST(test_tlist_add);
+   RUN_TEST(test_tlist_reverse);
+   RUN_TEST(test_tlist_delete);
+   RUN_TEST(test_tlist_index);
+   RUN_TEST(test_tlist_swap);
+   RUN_TEST(test_tlist_rotate);
+   RUN_TEST(test_tlist_concat_split);
+   RUN_TEST(test_tlist_destructor);
+
+   UnityEnd();
+   return 0;
+}
@@ -0,0 +1,168 @@
+#include <string.h>
+
+#include "vendor/unity.h"
+#include "../src/ulist.h"
+
+#define LENGTH(xs) (sizeof(xs) / sizeof(xs[0]))
+
+static int values[1000];
+
+void TEST_ASSERT_EQUAL_ULIST(UList *list, int *items[], int size) {
+    TEST_ASSERT_EQUAL_INT(size, list->size);
+    int i = 0;
+    for (UBlock *block = list->head; block; block = block->next) {
+        TEST_ASSERT_TRUE(block->count > 0);
+        TEST_ASSERT_TRUE(block->count <= UBLOCK_SIZE);
+        TEST_ASSERT_EQUAL_PTR(block, block->next ? block->next->prev : list->tail);
+        for (size_t j = 0; j < block->count; j++, i++) {
+            TEST_ASSERT_EQUAL_PTR(items[i], block->items[j]);
+        }
+    }
+    TEST_ASSERT_EQUAL_INT(size, i);
+    for (i = 0; i < size; i++) {
+        TEST_ASSERT_EQUAL_PTR(items[i], UList_get_at(list, i));
+    }
+}
+
+void test_ulist_new(void) {
+    UList *list = UList_new(NULL);
+
+    TEST_ASSERT_NULL(list->head);
+    TEST_ASSERT_NULL(list->tail);
+    TEST_ASSERT_EQUAL_INT(0, list->size);
+    TEST_ASSERT_TRUE(UList_is_empty(list));
+    TEST_ASSERT_FALSE(UList_has_some(list));
+
+    UList_free(list);
+}
+
+void test_ulist_add_head() {
+    UList *list = UList_new(NULL);
+    int *items[2 * UBLOCK_SIZE + 1];
+
+    for (int i = 0; i < (int) LENGTH(items); i++) {
+        UList_add_head(list, &values[i]);
+        items[LENGTH(items) - i - 1] = &values[i];
+    }
+    TEST_ASSERT_EQUAL_ULIST(list, items, LENGTH(items));
+    TEST_ASSERT_TRUE(UList_has_some(list));
+
+    UList_free(list);
+}
+
+void test_ulist_add_tail() {
+    UList *list = UList_new(NULL);
+    int *items[2 * UBLOCK_SIZE + 1];
+
+    for (int i = 0; i < (int) LENGTH(items); i++) {
+        UList_add_tail(list, &values[i]);
+        items[i] = &values[i];
+    }
+    TEST_ASSERT_EQUAL_ULIST(list, items, LENGTH(items));
+
+    UList_free(list);
+}
+
+void test_ulist_add_at() {
+    UList *list = UList_new(NULL);
+
+    TEST_ASSERT_FALSE(UList_add_at(list, 0, &values[0]));
+
+    UList_add_tail(list, &values[0]);
+    UList_add_tail(list, &values[1]);
+    TEST_ASSERT_FALSE(UList_add_at(list, -1, &values[2]));
+    TEST_ASSERT_FALSE(UList_add_at(list, 2, &values[2]));
+
+    TEST_ASSERT_TRUE(UList_add_at(list, 1, &values[2]));
+    TEST_ASSERT_TRUE(UList_add_at(list, 0, &values[3]));
+    int *items[] = { &values[3], &values[0], &values[2], &values[1] };
+    TEST_ASSERT_EQUAL_ULIST(list, items, LENGTH(items));
+
+    UList_free(list);
+}
+
+void test_ulist_get_index() {
+    UList *list = UList_new(NULL);
+
+    TEST_ASSERT_EQUAL_INT(-1, UList_get_index(list, &values[0]));
+
+    for (int i = 0; i < 3 * (int) UBLOCK_SIZE; i++) {
+        UList_add_tail(list, &values[i]);
+    }
+    for (int i = 0; i < 3 * (int) UBLOCK_SIZE; i++) {
+        TEST_ASSERT_EQUAL_INT(i, UList_get_index(list, &values[i]));
+    }
+    TEST_ASSERT_EQUAL_INT(-1, UList_get_index(list, NULL));
+    TEST_ASSERT_NULL(UList_get_at(list, -1));
+    TEST_ASSERT_NULL(UList_get_at(list, 3 * UBLOCK_SIZE));
+
+    UList_free(list);
+}
+
+void test_ulist_delete_at() {
+    UList *list = UList_new(free);
+
+    for (int i = 0; i < 3 * (int) UBLOCK_SIZE; i++) {
+        UList_add_tail(list, malloc(1));
+    }
+    UList_delete_at(list, 3 * UBLOCK_SIZE);
+    TEST_ASSERT_EQUAL_INT(3 * UBLOCK_SIZE, list->size);
+
+    while (list->size > 1) {
+        void *next = UList_get_at(list, 2);
+        UList_delete_at(list, 1);
+        TEST_ASSERT_EQUAL_PTR(next, UList_get_at(list, 1));
+    }
+    UList_delete_at(list, 0);
+    TEST_ASSERT_NULL(list->head);
+    TEST_ASSERT_NULL(list->tail);
+    TEST_ASSERT_TRUE(UList_is_empty(list));
+
+    UList_free(list);
+}
+
+void test_ulist_random() {
+    UList *list = UList_new(NULL);
+    int *items[LENGTH(values)];
+    int size = 0;
+
+    srand(1);
+    for (int step = 0; step < 5000; step++) {
+        int index = size ? rand() % size : 0;
+        if (size && (rand() % 3 == 0 || size == (int) LENGTH(values))) {
+            UList_delete_at(list, index);
+            memmove(items + index, items + index + 1, (size - index - 1) * sizeof(int *));
+            size--;
+        } else if (size) {
+            UList_add_at(list, index, &values[step % LENGTH(values)]);
+            memmove(items + index + 1, items + index, (size - index) * sizeof(int *));
+            items[index] = &values[step % LENGTH(values)];
+            size++;
+        } else {
+            UList_add_tail(list, &values[0]);
+            items[size++] = &values[0];
+        }
+    }
+    TEST_ASSERT_EQUAL_ULIST(list, items, size);
+
+    UList_clear(list);
+    TEST_ASSERT_NULL(list->head);
+    TEST_ASSERT_EQUAL_INT(0, list->size);
+
+    UList_free(list);
+}
+
+int main(void) {
+   UnityBegin("test/test_ulist.c");
+
+   RUN_TEST(test_ulist_new);
+   RUN_TEST(test_ulist_add_head);
+   RUN_TEST(test_ulist_add_tail);
+   RUN_TEST(test_ulist_add_at);
+   RUN_TEST(test_ulist_get_index);
+   RUN_TEST(test_ulist_delete_at);
+   RUN_TEST(test_ulist_random);
+
+   UnityEnd();
+   return 0;
+}
@@ -0,0 +1,142 @@
+#include "vendor/unity.h"
+#include "../src/xlist.h"
+
+#define LENGTH(xs) (sizeof(xs) / sizeof(xs[0]))
+
+void TEST_ASSERT_EQUAL_XLIST(XList *list, XNode *nodes[], int size) {
+    XCursor forward = XList_first(list);
+    XCursor backward = XList_last(list);
+    for (int i = 0; i < size; i++) {
+        TEST_ASSERT_EQUAL_PTR(nodes[i], forward.node);
+        TEST_ASSERT_EQUAL_PTR(nodes[size - i - 1], backward.node);
+        XList_next(&forward);
+        XList_next(&backward);
+    }
+    TEST_ASSERT_NULL(forward.node);
+    TEST_ASSERT_NULL(backward.node);
+    TEST_ASSERT_EQUAL_INT(size, list->size);
+}
+
+static int freed;
+
+static void count_free(void *data) {
+    (void) data;
+    freed++;
+}
+
+void test_xlist_new(void) {
+    XList *list = XList_new(NULL);
+
+    TEST_ASSERT_NULL(list->head);
+    TEST_ASSERT_NULL(list->tail);
+    TEST_ASSERT_NULL(XList_first(list).node);
+    TEST_ASSERT_EQUAL_INT(16, list->pool->size);
+
+    XList_free(list);
+}
+
+void test_xlist_add() {
+    XList *list = XList_new(NULL);
+    int items[3];
+
+    XNode *node1 = XList_add_tail(list, &items[0]);
+    XNode *node2 = XList_add_head(list, &items[1]);
+    XNode *node3 = XList_add_tail(list, &items[2]);
+    XNode *nodes[] = { node2, node1, node3 };
+    TEST_ASSERT_EQUAL_XLIST(list, nodes, LENGTH(nodes));
+    TEST_ASSERT_EQUAL_PTR(&items[1], node2->data);
+
+    XList_free(list);
+}
+
+void test_xlist_prev() {
+    XList *list = XList_new(NULL);
+    XNode *node1 = XList_add_tail(list, NULL);
+    XNode *node2 = XList_add_tail(list, NULL);
+    XNode *node3 = XList_add_tail(list, NULL);
+
+    XCursor cursor = XList_first(list);
+    XList_next(&cursor);
+    XList_next(&cursor);
+    TEST_ASSERT_EQUAL_PTR(node3, cursor.node);
+    XList_prev(&cursor);
+    TEST_ASSERT_EQUAL_PTR(node2, cursor.node);
+    XList_next(&cursor);
+    TEST_ASSERT_EQUAL_PTR(node1, cursor.node);
+    XList_next(&cursor);
+    TEST_ASSERT_NULL(cursor.node);
+
+    XList_free(list);
+}
+
+void test_xlist_reverse() {
+    XList *list = XList_new(NULL);
+    XNode *node1 = XList_add_tail(list, NULL);
+    XNode *node2 = XList_add_tail(list, NULL);
+    XNode *node3 = XList_add_tail(list, NULL);
+
+    XList_reverse(list);
+    XNode *nodes1[] = { node3, node2, node1 };
+    TEST_ASSERT_EQUAL_XLIST(list, nodes1, LENGTH(nodes1));
+
+    XNode *node4 = XList_add_head(list, NULL);
+    XNode *node5 = XList_add_tail(list, NULL);
+    XNode *nodes2[] = { node4, node3, node2, node1, node5 };
+    TEST_ASSERT_EQUAL_XLIST(list, nodes2, LENGTH(nodes2));
+
+    XList_free(list);
+}
+
+void test_xlist_delete() {
+    XList *list = XList_new(count_free);
+    XNode *nodes[6];
+    for (int i = 0; i < (int) LENGTH(nodes); i++) {
+        nodes[i] = XList_add_tail(list, NULL);
+    }
+    freed = 0;
+
+    XCursor cursor = XList_first(list);
+    XList_delete(list, &cursor);
+    TEST_ASSERT_EQUAL_PTR(nodes[1], cursor.node);
+    XList_next(&cursor);
+    XList_delete(list, &cursor);
+    TEST_ASSERT_EQUAL_PTR(nodes[3], cursor.node);
+    XNode *nodes1[] = { nodes[1], nodes[3], nodes[4], nodes[5] };
+    TEST_ASSERT_EQUAL_XLIST(list, nodes1, LENGTH(nodes1));
+
+    cursor = XList_last(list);
+    XList_delete(list, &cursor);
+    TEST_ASSERT_EQUAL_PTR(nodes[4], cursor.node);
+    XList_next(&cursor);
+    XList_next(&cursor);
+    XList_delete(list, &cursor);
+    TEST_ASSERT_NULL(cursor.node);
+    XNode *nodes2[] = { nodes[3], nodes[4] };
+    TEST_ASSERT_EQUAL_XLIST(list, nodes2, LENGTH(nodes2));
+    TEST_ASSERT_EQUAL_INT(4, freed);
+
+    XList_reverse(list);
+    cursor = XList_first(list);
+    XList_delete(list, &cursor);
+    XList_delete(list, &cursor);
+    TEST_ASSERT_NULL(cursor.node);
+    TEST_ASSERT_EQUAL_XLIST(list, NULL, 0);
+    TEST_ASSERT_EQUAL_INT(6, freed);
+
+    XList_add_tail(list, NULL);
+    XList_free(list);
+    TEST_ASSERT_EQUAL_INT(7, freed);
+}
+
+int main(void) {
+   UnityBegin("test/test_xlist.c");
+
+   RUN_TEST(test_xlist_new);
+   RUN_TEST(test_xlist_add);
+   RUN_TEST(test_xlist_prev);
+   RUN_TEST(test_xlist_reverse);
+   RUN_TEST(test_xlist_delete);
+
+   UnityEnd();
+   return 0;
+}